@@ -11,20 +11,28 @@
 #include "./priceFunctions/InverseExponentialPriceFunction.h"
 #include "./priceFunctions/EqualPriceFunction.h"
 #include "./priceFunctions/DropPriceFunction.h"
+#include "./priceFunctions/RankPrizePriceFunction.h"
 #include "./optimization/ExactHighestLastMappingOptimization.h"
 #include "./optimization/ExactHigestFirstMappingOptimization.h"
+#include "./optimization/AnnealingMappingOptimization.h"
 #include "./optimization/RandomizeMapping.h"
+#include "./samplers/Sampler.h"
 #include <utility>
 
-Configuration::Configuration(){
-    predictor = nullptr;
-    priceFunction = nullptr;
-}
+Configuration::Configuration() = default;
 
 Configuration::Configuration(mt19937* _rng, int** _schedule,map<vector<int>, tuple<float, float, float, int>> _teams){
     rng = _rng;
     schedule = _schedule;
-    teams = std::move(_teams);
+    shared_ptr<ConfigurationCore> core = make_shared<ConfigurationCore>();
+    core->teams = std::move(_teams);
+    this->core = core;
+}
+
+void Configuration::ownSchedule() {
+    if(schedule == nullptr) return;
+    scheduleData = make_shared<Schedule>(*scheduleData);
+    schedule = scheduleData->rows();
 }
 namespace fs = std::filesystem;
 std::string normalizePath(const std::string& path) {
@@ -34,14 +42,12 @@ std::string normalizePath(const std::string& path) {
     return resolvedPath.string();
 }
 
+// 64 random bits as 16 hex digits. The random streams of a configuration are keyed by its id,
+// so ids must not collide between the configurations of a sweep
 string generateHexID(mt19937* _rng) {
     std::stringstream ss;
-    std::random_device rd;
-    std::uniform_int_distribution<int> dis(0, 255);
-
-    int random = dis(*_rng);
-    for (int i = 0; i < 3; ++i) {
-        ss << std::hex << std::setw(2) << std::setfill('0') << random;
+    for (int i = 0; i < 2; ++i) {
+        ss << std::hex << std::setw(8) << std::setfill('0') << (uint32_t) (*_rng)();
     }
 
     return ss.str();
@@ -50,6 +56,7 @@ string generateHexID(mt19937* _rng) {
 Configuration::Configuration(mt19937* _rng, map<string, string> jsonMap, string _basePath){
     rng = _rng;
     basePath = _basePath;
+    shared_ptr<ConfigurationCore> core = make_shared<ConfigurationCore>();
         roundSwitchingOptimization = false;
         this->id = generateHexID(_rng);
         if(jsonMap.find("mapping") != jsonMap.end()) {
@@ -62,7 +69,7 @@ Configuration::Configuration(mt19937* _rng, map<string, string> jsonMap, string
                 map<vector<int>, tuple<float, float, float, int>> tempTeams = Data::readTeams(basePath + jsonMap["teams"]);
                 for (int i = 0; i < mapping.size(); ++i) {
                     for (int j = 0; j < mapping.size(); ++j) {
-                        teams[{
+                        core->teams[{
                                 i,
                                 j
                         }] = tempTeams[{
@@ -72,12 +79,12 @@ Configuration::Configuration(mt19937* _rng, map<string, string> jsonMap, string
                     }
                 }
                 numberOfTeams = (int)(mapping.size());
-                predictor = new TriplePredictor(teams, 0);
+                core->predictor.reset(new TriplePredictor(core->teams, 0));
             }
             else {
-                teams = Data::readTeams(basePath + jsonMap["teams"]);
-                numberOfTeams = (int)(pow(teams.size(),0.5)+0.05);
-                predictor = new TriplePredictor(teams, 0);
+                core->teams = Data::readTeams(basePath + jsonMap["teams"]);
+                numberOfTeams = (int)(pow(core->teams.size(),0.5)+0.05);
+                core->predictor.reset(new TriplePredictor(core->teams, 0));
             }
         }
         if(jsonMap.find("elo") != jsonMap.end()) {
@@ -86,18 +93,18 @@ Configuration::Configuration(mt19937* _rng, map<string, string> jsonMap, string
                 numberOfTeams = (int)(mapping.size());
                 vector<double> tempElo = Data::readElo(basePath + jsonMap["elo"]);
                 for (int i = 0; i < mapping.size(); ++i) {
-                    elo.push_back(tempElo[mapping[i]]);
+                    core->elo.push_back(tempElo[mapping[i]]);
                 }
-                ELOPredictor* _t = new ELOPredictor(elo);
-                predictor = _t;
-                teams = _t->TransformToTeams();
+                ELOPredictor* _t = new ELOPredictor(core->elo);
+                core->predictor.reset(_t);
+                core->teams = _t->TransformToTeams();
             }
             else {
-                elo = Data::readElo(basePath + jsonMap["elo"]);
-                ELOPredictor* _t = new ELOPredictor(elo);
-                predictor = _t;
-                teams = _t->TransformToTeams();
-                numberOfTeams = (int)(elo.size());
+                core->elo = Data::readElo(basePath + jsonMap["elo"]);
+                ELOPredictor* _t = new ELOPredictor(core->elo);
+                core->predictor.reset(_t);
+                core->teams = _t->TransformToTeams();
+                numberOfTeams = (int)(core->elo.size());
             }
         }
         if(jsonMap.find("selection") != jsonMap.end()) {
@@ -112,6 +119,12 @@ Configuration::Configuration(mt19937* _rng, map<string, string> jsonMap, string
                 if(part1 == "exactHighestFirst") {
                     pre["exactHighestFirst"] = true;
                 }
+                if(part1 == "annealingHighestLast") {
+                    pre["annealingHighestLast"] = true;
+                }
+                if(part1 == "annealingHighestFirst") {
+                    pre["annealingHighestFirst"] = true;
+                }
                 if(part1 == "random") {
                     pre["random"] = true;
                 }
@@ -121,7 +134,7 @@ Configuration::Configuration(mt19937* _rng, map<string, string> jsonMap, string
         }
         if(jsonMap.find("naming") != jsonMap.end()) {
             this->fileContent["naming"] = jsonMap["naming"];
-            naming = Data::readNaming(basePath + jsonMap["naming"]);
+            core->naming = Data::readNaming(basePath + jsonMap["naming"]);
         }
         mirrorSchedule = (jsonMap["mirrorSchedule"] == "true");
         if(!mirrorSchedule) {
@@ -129,22 +142,24 @@ Configuration::Configuration(mt19937* _rng, map<string, string> jsonMap, string
             rounds = get<0>(loadedSchedule);
             int** _schedule = get<1>(loadedSchedule);
 
-            schedule = new int*[rounds];
+            core->schedule = make_shared<Schedule>(rounds, numberOfTeams);
+            schedule = core->schedule->rows();
             for(int i = 0; i < rounds; i++) {
-                schedule[i] = new int[numberOfTeams];
                 for(int j = 0; j < numberOfTeams; j++) {
                     schedule[i][j] = selection[_schedule[i][j]];
                 }
+                delete[] _schedule[i];
             }
+            delete[] _schedule;
         }
         else {
             tuple<int, int**> loadedSchedule = Data::loadSchedule(basePath + jsonMap["schedule"]);
             this->fileContent["schedule"] = jsonMap["schedule"];
             rounds = 2*get<0>(loadedSchedule);
             int** singleSchedule = get<1>(loadedSchedule);
-            schedule = new int*[rounds];
+            core->schedule = make_shared<Schedule>(rounds, numberOfTeams);
+            schedule = core->schedule->rows();
             for(int i = 0; i < rounds; i++) {
-                schedule[i] = new int[numberOfTeams];
                 for(int j = 0; j < numberOfTeams; j++) {
                     if(i < numberOfTeams - 1) {
                         schedule[i][j] = singleSchedule[selection[i]][selection[j]];
@@ -159,30 +174,41 @@ Configuration::Configuration(mt19937* _rng, map<string, string> jsonMap, string
                     }
                 }
             }
+            for(int i = 0; i < get<0>(loadedSchedule); i++) {
+                delete[] singleSchedule[i];
+            }
+            delete[] singleSchedule;
         }
+        scheduleData = core->schedule;
         if(jsonMap.find("priceFunction") != jsonMap.end()) {
             this->fileContent["priceFunction"] = jsonMap["priceFunction"];
             if(jsonMap["priceFunction"] == "linear") {
-                priceFunction = new LinearPriceFunction(schedule, numberOfTeams);
+                core->priceFunction.reset(new LinearPriceFunction(schedule, numberOfTeams));
             }
             if(jsonMap["priceFunction"] == "winnerTakesAll") {
-                priceFunction = new WinnerTakesAllPriceFunction(schedule, numberOfTeams);
+                core->priceFunction.reset(new WinnerTakesAllPriceFunction(schedule, numberOfTeams));
             }
             if(jsonMap["priceFunction"] == "topThree") {
-                priceFunction = new TopThreePriceFunction(schedule, numberOfTeams);
+                core->priceFunction.reset(new TopThreePriceFunction(schedule, numberOfTeams));
             }
             if(jsonMap["priceFunction"] == "inverseExponential") {
-                priceFunction = new InverseExponentialPriceFunction(schedule, numberOfTeams);
+                core->priceFunction.reset(new InverseExponentialPriceFunction(schedule, numberOfTeams));
             }
             if(jsonMap["priceFunction"] == "equal") {
-                priceFunction = new EqualPriceFunction(schedule, numberOfTeams);
+                core->priceFunction.reset(new EqualPriceFunction(schedule, numberOfTeams));
             }
             if(jsonMap["priceFunction"] == "drop") {
-                priceFunction = new DropPriceFunction(schedule, numberOfTeams);
+                core->priceFunction.reset(new DropPriceFunction(schedule, numberOfTeams));
+            }
+            if(jsonMap["priceFunction"].rfind("table;", 0) == 0) {
+                core->priceFunction.reset(new RankPrizePriceFunction(schedule, numberOfTeams, RankPrizePriceFunction::parseTable(jsonMap["priceFunction"], numberOfTeams)));
+            }
+            if(!core->priceFunction) {
+                throw runtime_error("Error: unknown price function " + jsonMap["priceFunction"]);
             }
         }
         else {
-            priceFunction = new WinnerTakesAllPriceFunction(schedule, numberOfTeams);
+            core->priceFunction.reset(new WinnerTakesAllPriceFunction(schedule, numberOfTeams));
         }
         
         if(jsonMap.find("runs") != jsonMap.end()) {
@@ -202,6 +228,91 @@ Configuration::Configuration(mt19937* _rng, map<string, string> jsonMap, string
         } else {
             this->postRuns = this->runs;
         }
+        if(jsonMap.find("threads") != jsonMap.end()) {
+            this->threads = stoi(jsonMap["threads"]);
+        }
+        if(jsonMap.find("estimator") != jsonMap.end()) {
+            if(jsonMap["estimator"] != "independent" && jsonMap["estimator"] != "common") {
+                throw runtime_error("Error: unknown estimator " + jsonMap["estimator"] + ", expected independent or common");
+            }
+            this->estimator = jsonMap["estimator"];
+        }
+        if(jsonMap.find("sampler") != jsonMap.end()) {
+            if(!Sampler::exists(jsonMap["sampler"])) {
+                throw runtime_error("Error: unknown sampler " + jsonMap["sampler"] + ", expected philox, mt19937, xoshiro or sobol");
+            }
+            this->sampler = jsonMap["sampler"];
+        }
+        if(jsonMap.find("importance") != jsonMap.end()) {
+            this->importance = stod(jsonMap["importance"]);
+        }
+        if(jsonMap.find("distMass") != jsonMap.end()) {
+            this->distMass = stod(jsonMap["distMass"]);
+            if(this->distMass <= 0.0 || this->distMass > 1.0) {
+                throw runtime_error("Error: distMass must be in (0, 1]");
+            }
+        }
+        if(jsonMap.find("distMerge") != jsonMap.end()) {
+            this->distMerge = jsonMap["distMerge"] == "true";
+        }
+        if(jsonMap.find("targetError") != jsonMap.end()) {
+            this->targetError = stod(jsonMap["targetError"]);
+        }
+        if(jsonMap.find("maxRuns") != jsonMap.end()) {
+            this->maxRuns = stoi(jsonMap["maxRuns"]);
+        }
+        if(this->maxRuns < 0) {
+            this->maxRuns = 10 * this->postRuns;
+        }
+        if(jsonMap.find("tailEnumeration") != jsonMap.end()) {
+            this->tailEnumeration = stol(jsonMap["tailEnumeration"]);
+        }
+        if(this->tailEnumeration < 0) {
+            this->tailEnumeration = this->postRuns;
+        }
+        if(jsonMap.find("engine") != jsonMap.end()) {
+            if(jsonMap["engine"] != "simulated" && jsonMap["engine"] != "exact") {
+                throw runtime_error("Error: unknown engine " + jsonMap["engine"] + ", expected simulated or exact");
+            }
+            this->engine = jsonMap["engine"];
+        }
+        if(jsonMap.find("stateBudget") != jsonMap.end()) {
+            this->stateBudget = stol(jsonMap["stateBudget"]);
+        }
+        if(jsonMap.find("annealingSteps") != jsonMap.end()) {
+            this->annealingSteps = stol(jsonMap["annealingSteps"]);
+            if(this->annealingSteps < 0) {
+                throw runtime_error("Error: annealingSteps must not be negative");
+            }
+        }
+        if(jsonMap.find("annealingRestarts") != jsonMap.end()) {
+            this->annealingRestarts = stoi(jsonMap["annealingRestarts"]);
+            if(this->annealingRestarts < 1) {
+                throw runtime_error("Error: annealingRestarts must be at least 1");
+            }
+        }
+        if(jsonMap.find("annealingTime") != jsonMap.end()) {
+            this->annealingTime = stod(jsonMap["annealingTime"]);
+        }
+        if(jsonMap.find("roundSwitching") != jsonMap.end()) {
+            if(jsonMap["roundSwitching"] != "none" && jsonMap["roundSwitching"] != "total" && jsonMap["roundSwitching"] != "max") {
+                throw runtime_error("Error: unknown roundSwitching " + jsonMap["roundSwitching"] + ", expected none, total or max");
+            }
+            this->roundSwitchingOptimization = jsonMap["roundSwitching"] != "none";
+            pre["roundSwitching"] = this->roundSwitchingOptimization;
+            if(this->roundSwitchingOptimization) {
+                this->roundSwitchingObjective = jsonMap["roundSwitching"];
+            }
+        }
+        if(jsonMap.find("roundSwitchingCandidates") != jsonMap.end()) {
+            this->roundSwitchingCandidates = stoi(jsonMap["roundSwitchingCandidates"]);
+            if(this->roundSwitchingCandidates < 0) {
+                throw runtime_error("Error: roundSwitchingCandidates must not be negative");
+            }
+        }
+        predictor = core->predictor.get();
+        priceFunction = core->priceFunction.get();
+        this->core = core;
 }
 
 
@@ -215,15 +326,47 @@ Configuration Configuration::loadConfiguration(mt19937* _rng, const std::string
     size_t pos = fileName.find_last_of('/');
     string basePath = fileName.substr(0, pos+1);
     Configuration _t = Configuration(_rng, jsonString, basePath);
-    if(_t.pre["exactHighestLast"]) {
+    applyOptimizations(_t);
+    return _t;
+}
+
+// Mapping optimizations selected by the prefix of the mapping file. The round order is optimized later,
+// by the job that calculates the configuration
+void Configuration::applyOptimizations(Configuration& config) {
+    if(config.pre["exactHighestLast"]) {
         ExactHighestLastMappingOptimization opt = ExactHighestLastMappingOptimization();
-        _t = opt.optimize(_t);
+        config = opt.optimize(config);
     }
-    if(_t.pre["exactHighestFirst"]) {
+    if(config.pre["exactHighestFirst"]) {
         ExactHigestFirstMappingOptimization opt = ExactHigestFirstMappingOptimization();
-        _t = opt.optimize(_t);
+        config = opt.optimize(config);
+    }
+    if(config.pre["annealingHighestLast"]) {
+        AnnealingMappingOptimization opt = AnnealingMappingOptimization(true);
+        config = opt.optimize(config);
+    }
+    if(config.pre["annealingHighestFirst"]) {
+        AnnealingMappingOptimization opt = AnnealingMappingOptimization(false);
+        config = opt.optimize(config);
+    }
+}
+
+// A random mapping configuration becomes runs configurations with one random mapping each, others are added as they are
+void Configuration::expandRandomMappings(Configuration config, vector<Configuration>& configVector) {
+    if(!config.pre["random"]) {
+        configVector.push_back(config);
+        return;
+    }
+    int originalRuns = config.runs;
+    config.preRuns = 1;
+    for (int i = 0; i < originalRuns; ++i) {
+        Configuration randomizedConfig = config;
+        // Every random mapping gets its own id, so it is simulated with its own random numbers
+        randomizedConfig.id = config.id + "-" + to_string(i);
+        RandomizeMapping randomizer;
+        randomizedConfig = randomizer.optimize(randomizedConfig);
+        configVector.push_back(randomizedConfig);
     }
-    return _t;
 }
 
 vector<Configuration> Configuration::loadConfigurations(mt19937* _rng, const std::string &fileName) {
@@ -235,53 +378,15 @@ vector<Configuration> Configuration::loadConfigurations(mt19937* _rng, const std
         vector<map<string, string>> jsonArray = parseJSONArray(jsonString);
         for (const auto& jsonObject : jsonArray) {
             Configuration _t = Configuration(_rng, jsonObject, basePath);
-            if(_t.pre["exactHighestLast"]) {
-                ExactHighestLastMappingOptimization opt = ExactHighestLastMappingOptimization();
-                _t = opt.optimize(_t);
-            }
-            if(_t.pre["exactHighestFirst"]) {
-                ExactHigestFirstMappingOptimization opt = ExactHigestFirstMappingOptimization();
-                _t = opt.optimize(_t);
-            }
-            if(_t.pre["random"]) {
-                int originalRuns = _t.runs;
-                _t.preRuns = 1;
-                for (int i = 0; i < originalRuns; ++i) {
-                    Configuration randomizedConfig = _t;
-                    RandomizeMapping randomizer;
-                    randomizedConfig = randomizer.optimize(randomizedConfig);
-                    configVector.push_back(randomizedConfig);
-                }
-            }
-            else {
-                configVector.push_back(_t);
-            }
+            applyOptimizations(_t);
+            expandRandomMappings(_t, configVector);
         }
     }
     else if(isJSONObject(jsonString)) {
         map<std::string, std::string> jsonObject = parseJSONObject(jsonString);
         Configuration _t = Configuration(_rng, jsonObject, basePath);
-        if(_t.pre["exactHighestLast"]) {
-            ExactHighestLastMappingOptimization opt = ExactHighestLastMappingOptimization();
-            _t = opt.optimize(_t);
-        }
-        if(_t.pre["exactHighestFirst"]) {
-            ExactHigestFirstMappingOptimization opt = ExactHigestFirstMappingOptimization();
-            _t = opt.optimize(_t);
-        }
-        if(_t.pre["random"]) {
-            int originalRuns = _t.runs;
-            _t.preRuns = 1;
-            for (int i = 0; i < originalRuns; ++i) {
-                Configuration randomizedConfig = _t;
-                RandomizeMapping randomizer;
-                randomizedConfig = randomizer.optimize(randomizedConfig);
-                configVector.push_back(randomizedConfig);
-            }
-        }
-        else {
-            configVector.push_back(_t);
-        }
+        applyOptimizations(_t);
+        expandRandomMappings(_t, configVector);
     }
     return configVector;
 }
@@ -296,7 +401,8 @@ std::string generateJsonString(
         const std::vector<std::string>& priceFunction,
         const std::vector<std::string>& runs,
         const std::vector<std::string>& preRuns,
-        const std::vector<std::string>& postRuns)
+        const std::vector<std::string>& postRuns,
+        const std::map<std::string, std::string>& settings)
 {
     std::ostringstream oss;
     oss << "[";
@@ -328,8 +434,12 @@ std::string generateJsonString(
                             if (!first) oss << ",";
                             first = false;
 
-                            oss << "{" << std::endl
-                                << "\"schedule\":\"" << s << "\"," << std::endl;
+                            oss << "{" << std::endl;
+                            // Settings that are shared by every generated configuration
+                            for (const auto& setting : settings) {
+                                oss << "\"" << setting.first << "\":\"" << setting.second << "\"," << std::endl;
+                            }
+                            oss << "\"schedule\":\"" << s << "\"," << std::endl;
 
                             // Dynamically decide the key based on value
                             if (dataSource.find("teams") != std::string::npos) {
@@ -364,8 +474,8 @@ std::string generateJsonString(
     return oss.str();
 }
 
-vector<Configuration> Configuration::generateConfigurations(mt19937* _rng, vector<string> schedule, vector<string> teams, vector<string> elo, vector<string> selection, vector<string> mapping, vector<string> naming, vector<string> priceFunction, vector<string> runs, vector<string> preRuns, vector<string> postRuns, string _basePath) {
-    string jsonString = generateJsonString(schedule, teams, elo, selection, mapping, naming, priceFunction, runs, preRuns, postRuns);
+vector<Configuration> Configuration::generateConfigurations(mt19937* _rng, vector<string> schedule, vector<string> teams, vector<string> elo, vector<string> selection, vector<string> mapping, vector<string> naming, vector<string> priceFunction, vector<string> runs, vector<string> preRuns, vector<string> postRuns, map<string, string> settings, string _basePath) {
+    string jsonString = generateJsonString(schedule, teams, elo, selection, mapping, naming, priceFunction, runs, preRuns, postRuns, settings);
 
     vector<map<string, string>> jsonArray = parseJSONArray(jsonString);
     vector<Configuration> configVector = {};
@@ -374,83 +484,8 @@ vector<Configuration> Configuration::generateConfigurations(mt19937* _rng, vecto
     for (const auto& jsonObject : jsonArray) {
         count++;
         Configuration _t = Configuration(_rng, jsonObject, _basePath);
-        for (const auto& pair : jsonObject) {
-        }
-        if(_t.pre["exactHighestLast"]) {
-            ExactHighestLastMappingOptimization opt = ExactHighestLastMappingOptimization();
-            _t = opt.optimize(_t);
-        }
-        if(_t.pre["exactHighestFirst"]) {
-            ExactHigestFirstMappingOptimization opt = ExactHigestFirstMappingOptimization();
-            _t = opt.optimize(_t);
-        }
-        if(_t.pre["random"]) {
-            int originalRuns = _t.runs;
-            _t.preRuns = 1;
-            for (int i = 0; i < originalRuns; ++i) {
-                Configuration randomizedConfig = _t;
-                RandomizeMapping randomizer;
-                randomizedConfig = randomizer.optimize(randomizedConfig);
-                configVector.push_back(randomizedConfig);
-            }
-        }
-        else {
-            configVector.push_back(_t);
-        }
+        applyOptimizations(_t);
+        expandRandomMappings(_t, configVector);
     }
     return configVector;
 }
-
-Configuration::Configuration(const Configuration& other) {
-    this->id = other.id;
-    this->predictor = other.predictor->clone();
-    this->priceFunction = other.priceFunction->clone();
-    this->elo = other.elo;
-    this->teams = other.teams;
-    this->schedule = other.schedule;
-    this->numberOfTeams = other.numberOfTeams;
-    this->rng = other.rng;
-    this->mapping = other.mapping;
-    this->name = other.name;
-    this->mirrorSchedule = other.mirrorSchedule;
-    this->rounds = other.rounds;
-    this->fileContent = other.fileContent;
-    this->roundSwitchingOptimization = other.roundSwitchingOptimization;
-    this->pre = other.pre;
-    this->runs = other.runs;
-    this->preRuns = other.preRuns;
-    this->postRuns = other.postRuns;
-}
-
-Configuration& Configuration::operator=(const Configuration& other) {
-    if (this == &other)
-        return *this;
-    delete this->predictor;
-    this->id = other.id;
-
-    this->predictor = other.predictor->clone();
-    this->priceFunction = other.priceFunction->clone();
-    this->elo = other.elo;
-    this->teams = other.teams;
-    this->schedule = other.schedule;
-    this->numberOfTeams = other.numberOfTeams;
-    this->rng = other.rng;
-    this->mapping = other.mapping;
-    this->name = other.name;
-    this->mirrorSchedule = other.mirrorSchedule;
-    this->rounds = other.rounds;
-    this->fileContent = other.fileContent;
-    this->roundSwitchingOptimization = other.roundSwitchingOptimization;
-    this->pre = other.pre;
-    this->runs = other.runs;
-    this->preRuns = other.preRuns;
-    this->postRuns = other.postRuns;
-    return *this;
-}
-
-Configuration::~Configuration() {
-    delete predictor;
-    predictor = nullptr;
-    delete priceFunction;
-    priceFunction = nullptr;
-}
\ No newline at end of file
@@ -4,9 +4,9 @@
 #include <random>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
-#include "./Predictor.h"
-#include "./priceFunctions/PriceFunction.h"
+#include "./ConfigurationCore.h"
 using namespace std;
 
 
@@ -16,20 +16,26 @@ private:
 public:
     map<string, bool> pre = {
             {"exactHighestLast", false},
-            {"exactHighestFirst", false}
+            {"exactHighestFirst", false},
+            {"annealingHighestLast", false},
+            {"annealingHighestFirst", false},
+            {"roundSwitching", false}
     };
-    Configuration& operator=(const Configuration& other);
-    Predictor* predictor;
-    PriceFunction* priceFunction;
-    vector<double> elo;
-    map<vector<int>, tuple<float, float, float, int>> teams;
-    int** schedule;
+    // Loaded inputs shared with every copy of this configuration
+    shared_ptr<const ConfigurationCore> core;
+    // The predictor and price function of the core
+    Predictor* predictor = nullptr;
+    PriceFunction* priceFunction = nullptr;
+    // Rows of scheduleData, which starts out as the schedule of the core
+    int** schedule = nullptr;
+    shared_ptr<Schedule> scheduleData;
     int numberOfTeams;
     mt19937* rng;
-    int* selection;
+    vector<int> selection;
     vector<int> mapping;
-    bool roundSwitchingOptimization;
-    map<int, string> naming;
+    bool roundSwitchingOptimization = false;
+    string roundSwitchingObjective = "total";  // Fraud the round order optimization lowers: "total" of all games or "max" of one game
+    int roundSwitchingCandidates = 4;  // Round orders besides the current one that the round order optimization calculates
     string name;
     string basePath;
     map<string, string> fileContent;
@@ -38,17 +44,33 @@ public:
     Configuration(mt19937* _rng, map<string, string> jsonMap, string _basePath);
     Configuration();
     static vector<Configuration> loadConfigurations(mt19937* _rng, const std::string &fileName);
-    static vector<Configuration> generateConfigurations(mt19937* _rng, vector<string> schedule, vector<string> teams, vector<string> elo, vector<string> selection, vector<string> mapping, vector<string> naming, vector<string> priceFunction, vector<string> runs, vector<string> preRuns, vector<string> postRuns, string _basePath);
+    static vector<Configuration> generateConfigurations(mt19937* _rng, vector<string> schedule, vector<string> teams, vector<string> elo, vector<string> selection, vector<string> mapping, vector<string> naming, vector<string> priceFunction, vector<string> runs, vector<string> preRuns, vector<string> postRuns, map<string, string> settings, string _basePath);
     static Configuration loadConfiguration(mt19937* _rng, const std::string &fileName);
+    static void applyOptimizations(Configuration& config);
+    static void expandRandomMappings(Configuration config, vector<Configuration>& configVector);
+    // Give this configuration its own copy of the schedule before changing it, copies share it otherwise
+    void ownSchedule();
     bool mirrorSchedule;
     int rounds;
     float cutoff = 2.0;
-    ~Configuration();
-    Configuration(const Configuration& other);
     string id;
     int runs = 10;  // Default number of runs for simulations
     int preRuns = 10;  // Default number of pre-runs for table calculation (will be set to runs if not specified)
     int postRuns = 10;  // Default number of post-runs for EV calculation (will be set to runs if not specified)
+    int threads = 1;  // Worker threads used by the simulation of this configuration
+    string estimator = "independent";  // "independent" or "common" random numbers for the four collusion strategies
+    string sampler = "philox";  // Source of the uniform numbers: "philox", "mt19937", "xoshiro" or "sobol"
+    double importance = 0.0;  // Tilt of the pre-runs toward close standings, 0 samples them from the predictor
+    double distMass = 1.0;  // Smallest probability mass of the pre-run score distribution that is evaluated, 1 keeps every state
+    bool distMerge = false;  // Merge score states that only differ by the same points for every team
+    double targetError = 0.0;  // Simulate batches of postRuns until the standard error of every fraud value is at most this, 0 runs postRuns once
+    int maxRuns = -1;  // Largest number of post-runs per game when targetError is set, -1 uses 10 times postRuns
+    long tailEnumeration = 0;  // Enumerate the rest of the season instead of sampling it when it has at most this many outcomes, 0 always samples, -1 uses postRuns
+    string engine = "simulated";  // "simulated" or "exact" fraud value calculation
+    long stateBudget = 1000000;  // Largest number of distinct score states the exact engine may keep
+    long annealingSteps = 1000000;  // Swaps tried by every restart of the annealing mapping optimization
+    int annealingRestarts = 8;  // Independent restarts of the annealing mapping optimization
+    double annealingTime = 0.0;  // Time budget of the whole annealing mapping optimization in seconds, 0 runs all steps
 };
 
 
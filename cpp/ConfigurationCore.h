@@ -0,0 +1,29 @@
+#ifndef THESIS_CONFIGURATIONCORE_H
+#define THESIS_CONFIGURATIONCORE_H
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "./Predictor.h"
+#include "./Schedule.h"
+#include "./priceFunctions/PriceFunction.h"
+
+using namespace std;
+
+// The inputs of a configuration that are loaded once and never change afterwards: match odds, Elo ratings,
+// team names, the schedule and the predictor and price function built from them.
+// All copies of a configuration share one core, so copying a configuration does not copy these
+class ConfigurationCore {
+public:
+    vector<double> elo;
+    map<vector<int>, tuple<float, float, float, int>> teams;
+    map<int, string> naming;
+    shared_ptr<Schedule> schedule;
+    unique_ptr<Predictor> predictor;
+    unique_ptr<PriceFunction> priceFunction;
+};
+
+
+#endif //THESIS_CONFIGURATIONCORE_H
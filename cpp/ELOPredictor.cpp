@@ -3,40 +3,139 @@
 //
 
 #include "ELOPredictor.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define THESIS_X86_KERNELS
+#include <immintrin.h>
+#endif
 
 ELOPredictor::ELOPredictor(vector<double> elo) : Predictor(){
     this->elo = elo;
+    rebuild();
 }
 
-int ELOPredictor::predict(float rng, const vector<int>& index, map<vector<int>, tuple<float, float, float, int>> adaptations) {
-    if(adaptations.find(index) != adaptations.end()) {
-        if(rng < get<0>(adaptations[index])) {
-            return 0;
-        }
-        else if(rng < (get<0>(adaptations[index]) + get<1>(adaptations[index]))) {
-            return 1;
+// Smallest float that is not below value, so a float draw compares against it exactly as against the double
+static float floatThreshold(double value) {
+    float threshold = (float) value;
+    if((double) threshold < value) {
+        threshold = nextafter(threshold, numeric_limits<float>::infinity());
+    }
+    return threshold;
+}
+
+static void transformScalar(double home, const double* away, double theta, float* thresholds, int begin, int end) {
+    for(int j = begin; j < end; j++) {
+        double alpha = home * away[j];
+        double homeWin = 1 / (theta * alpha + 1);
+        double awayWin = alpha / (theta + alpha);
+        thresholds[2*j] = floatThreshold(homeWin);
+        thresholds[2*j+1] = floatThreshold(homeWin + awayWin);
+    }
+}
+
+#ifdef THESIS_X86_KERNELS
+// Four pairs per step. The thresholds are positive, so rounding a float up to the next one adds 1 to its bits
+__attribute__((target("avx2")))
+static int transformAvx2(double home, const double* away, double theta, float* thresholds, int n) {
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d h = _mm256_set1_pd(home);
+    const __m256d t = _mm256_set1_pd(theta);
+    // Picks the low halves of the four 64-bit comparison masks
+    const __m256i even = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    int j = 0;
+    for(; j + 4 <= n; j += 4) {
+        __m256d alpha = _mm256_mul_pd(h, _mm256_loadu_pd(away + j));
+        __m256d homeWin = _mm256_div_pd(one, _mm256_add_pd(_mm256_mul_pd(t, alpha), one));
+        __m256d awayWin = _mm256_div_pd(alpha, _mm256_add_pd(t, alpha));
+        __m256d values[2] = {homeWin, _mm256_add_pd(homeWin, awayWin)};
+        __m128 rounded[2];
+        for(int c = 0; c < 2; c++) {
+            __m128 narrow = _mm256_cvtpd_ps(values[c]);
+            __m256i below = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_cvtps_pd(narrow), values[c], _CMP_LT_OQ));
+            __m128i up = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(below, even));
+            rounded[c] = _mm_castsi128_ps(_mm_sub_epi32(_mm_castps_si128(narrow), up));
         }
-        return 2;
+        _mm_storeu_ps(thresholds + 2*j, _mm_unpacklo_ps(rounded[0], rounded[1]));
+        _mm_storeu_ps(thresholds + 2*j + 4, _mm_unpackhi_ps(rounded[0], rounded[1]));
     }
-    if (elo.empty()) {
-        throw runtime_error("Error: elo map is not defined!");
+    return j;
+}
+#endif
+
+void ELOPredictor::factor(int team) {
+    home[team] = pow(10, -(elo[team] + 100) / 200);
+    away[team] = pow(10, elo[team] / 200);
+}
+
+// Thresholds of team playing at home against every team
+void ELOPredictor::transformRow(int team) {
+    int n = (int) elo.size();
+    float* row = &table[2 * (size_t) team * n];
+    int j = 0;
+#ifdef THESIS_X86_KERNELS
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if(avx2) j = transformAvx2(home[team], away.data(), theta, row, n);
+#endif
+    transformScalar(home[team], away.data(), theta, row, j, n);
+    row[2*team] = row[2*team+1] = 0.0f;
+}
+
+// Thresholds of every team playing at home against team
+void ELOPredictor::transformColumn(int team) {
+    int n = (int) elo.size();
+    for(int i = 0; i < n; i++) {
+        if(i == team) continue;
+        transformScalar(home[i], away.data(), theta, &table[2 * (size_t) i * n], team, team + 1);
     }
-    double alpha = pow(10,-(elo[index[0]] + 100 - elo[index[1]])/200);
-    double theta = exp(cutoff);
+}
 
-    vector<double> odds = {
-            1 / (theta * alpha + 1),
-            alpha / (theta + alpha),
-            (alpha * (pow(theta, 2) - 1)) / ((alpha + theta) * (alpha * theta + 1))
-    };
+void ELOPredictor::rebuild() {
+    int n = (int) elo.size();
+    home.assign(n, 0.0);
+    away.assign(n, 0.0);
+    for(int i = 0; i < n; i++) {
+        factor(i);
+    }
+    theta = exp(cutoff);
+    table.assign(2 * (size_t) n * n, 0.0f);
+    for(int i = 0; i < n; i++) {
+        transformRow(i);
+    }
+}
 
-    if(rng < odds[0]) {
-        return 0;
+void ELOPredictor::setElo(int team, double value) {
+    if(team < 0 || team >= (int) elo.size()) {
+        throw out_of_range("Error: no elo rating for team " + to_string(team));
     }
-    else if(rng < odds[0] + odds[1]) {
-        return 1;
+    elo[team] = value;
+    factor(team);
+    transformRow(team);
+    transformColumn(team);
+}
+
+void ELOPredictor::setCutoff(float cutoff) {
+    this->cutoff = cutoff;
+    rebuild();
+}
+
+pair<float, float> ELOPredictor::cumulativeOdds(int homeTeam, int awayTeam) const {
+    if (elo.empty()) {
+        throw runtime_error("Error: elo map is not defined!");
     }
-    return 2;
+    const float* t = &table[2 * ((size_t) homeTeam * elo.size() + awayTeam)];
+    return make_pair(t[0], t[1]);
+}
+
+void ELOPredictor::fillThresholds(int numberOfTeams, float* thresholds) const {
+    if((int) elo.size() != numberOfTeams) {
+        Predictor::fillThresholds(numberOfTeams, thresholds);
+        return;
+    }
+    memcpy(thresholds, table.data(), table.size() * sizeof(float));
 }
 
 Predictor* ELOPredictor::clone() {
@@ -44,7 +143,13 @@ Predictor* ELOPredictor::clone() {
 }
 
 ELOPredictor::ELOPredictor(const ELOPredictor& other) {
+    this->number = other.number;
     this->elo = other.elo;
+    this->cutoff = other.cutoff;
+    this->home = other.home;
+    this->away = other.away;
+    this->theta = other.theta;
+    this->table = other.table;
 }
 
 map<vector<int>, tuple<float, float, float, int>> ELOPredictor::TransformToTeams() {
@@ -56,17 +161,14 @@ map<vector<int>, tuple<float, float, float, int>> ELOPredictor::TransformToTeams
                 teams[index] = make_tuple(0.0,0.0,0.0,0);
             }
             else {
-                double alpha = pow(10,-(elo[index[0]] + 100 - elo[index[1]])/200);
-                double theta = exp(cutoff);
-
-                vector<double> odds = {
+                double alpha = home[i] * away[j];
+                teams[index] = make_tuple(
                         1 / (theta * alpha + 1),
                         alpha / (theta + alpha),
-                        (alpha * (pow(theta, 2) - 1)) / ((alpha + theta) * (alpha * theta + 1))
-                };
-                teams[index] = make_tuple(odds[0],odds[1],odds[2],0);
+                        (alpha * (pow(theta, 2) - 1)) / ((alpha + theta) * (alpha * theta + 1)),
+                        0);
             }
         }
     }
     return teams;
-}
\ No newline at end of file
+}
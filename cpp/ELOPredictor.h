@@ -3,15 +3,37 @@
 
 #include "./Predictor.h"
 
+// Odds from the Elo ratings of the two teams. alpha = 10^(-(elo[home] + 100 - elo[away]) / 200)
+// factors into a home term of the home team times an away term of the away team, so the thresholds of all pairs
+// are computed once into a dense table and only the affected row and column are redone when a rating changes
 class ELOPredictor : public Predictor {
-public:
+private:
+    // Ratings and draw cutoff the table is built from, only changed through setElo and setCutoff so it never goes stale
     vector<double> elo;
+    float cutoff = 2.77;
+    // Factors of alpha per team: home[i] * away[j] is alpha of i playing at home against j
+    vector<double> home;
+    vector<double> away;
+    double theta = 0.0;
+    // Cumulative thresholds of all pairs, in the layout of OutcomeTable
+    vector<float> table;
+    void factor(int team);
+    void transformRow(int team);
+    void transformColumn(int team);
+    void rebuild();
+public:
     ELOPredictor(vector<double> elo);
-    int predict(float rng, const vector<int>& index, map<vector<int>, tuple<float, float, float, int>> adaptations) override;
+    pair<float, float> cumulativeOdds(int homeTeam, int awayTeam) const override;
+    void fillThresholds(int numberOfTeams, float* thresholds) const override;
     Predictor* clone() override;
     map<vector<int>, tuple<float, float, float, int>>  TransformToTeams();
     ELOPredictor(const ELOPredictor& other);
-    float cutoff = 2.77;
+    const vector<double>& getElo() const { return elo; }
+    float getCutoff() const { return cutoff; }
+    // Change a rating, only the row and column of the team in the odds table are redone
+    void setElo(int team, double value);
+    // Change the draw cutoff, the whole odds table is redone
+    void setCutoff(float cutoff);
 };
 
 
@@ -0,0 +1,75 @@
+#include "OutcomeTable.h"
+#include <stdexcept>
+#include <string>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define THESIS_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+OutcomePatches::OutcomePatches() = default;
+
+OutcomePatches::OutcomePatches(int homeTeam, int awayTeam, float homeWin, float awayWin) {
+    add(homeTeam, awayTeam, homeWin, awayWin);
+}
+
+void OutcomePatches::add(int homeTeam, int awayTeam, float homeWin, float awayWin) {
+    if(count >= capacity) {
+        throw runtime_error("Error: too many outcome patches, at most " + to_string(capacity) + " are supported");
+    }
+    this->homeTeam[count] = homeTeam;
+    this->awayTeam[count] = awayTeam;
+    thresholds[count][0] = homeWin;
+    thresholds[count][1] = homeWin + awayWin;
+    count++;
+}
+
+OutcomeTable::OutcomeTable() = default;
+
+OutcomeTable::OutcomeTable(const Predictor& predictor, int numberOfTeams) {
+    this->numberOfTeams = numberOfTeams;
+    thresholds.assign(2 * numberOfTeams * numberOfTeams, 0.0f);
+    predictor.fillThresholds(numberOfTeams, thresholds.data());
+}
+
+void OutcomeTable::lookup(int** schedule, int start, int end, const OutcomePatches& patches, float* low, float* high) const {
+    int games = numberOfTeams / 2;
+    for(int j = start; j < end; j++) {
+        for(int k = 0; k < games; k++) {
+            const float* t = odds(schedule[j][2*k], schedule[j][2*k+1], patches);
+            int cell = (j - start) * games + k;
+            low[cell] = t[0];
+            high[cell] = t[1];
+        }
+    }
+}
+
+#ifdef THESIS_X86_KERNELS
+// Eight matches per step, the comparison masks are -1 so their negated sum is the outcome
+__attribute__((target("avx2")))
+static int decideAvx2(const float* uniforms, const float* low, const float* high, int8_t* outcomes, int n) {
+    const __m256i zero = _mm256_setzero_si256();
+    int c = 0;
+    for(; c + 8 <= n; c += 8) {
+        __m256 u = _mm256_loadu_ps(uniforms + c);
+        __m256i first = _mm256_castps_si256(_mm256_cmp_ps(u, _mm256_loadu_ps(low + c), _CMP_GE_OQ));
+        __m256i second = _mm256_castps_si256(_mm256_cmp_ps(u, _mm256_loadu_ps(high + c), _CMP_GE_OQ));
+        __m256i outcome = _mm256_sub_epi32(zero, _mm256_add_epi32(first, second));
+        __m256i bytes = _mm256_packs_epi16(_mm256_packs_epi32(outcome, zero), zero);
+        __m128i packed = _mm_unpacklo_epi32(_mm256_castsi256_si128(bytes), _mm256_extracti128_si256(bytes, 1));
+        _mm_storel_epi64((__m128i*) (outcomes + c), packed);
+    }
+    return c;
+}
+#endif
+
+void OutcomeTable::decide(const float* uniforms, const float* low, const float* high, int8_t* outcomes, int n) {
+    int c = 0;
+#ifdef THESIS_X86_KERNELS
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if(avx2) c = decideAvx2(uniforms, low, high, outcomes, n);
+#endif
+    for(; c < n; c++) {
+        outcomes[c] = (int8_t) ((uniforms[c] >= low[c]) + (uniforms[c] >= high[c]));
+    }
+}
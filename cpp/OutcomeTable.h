@@ -0,0 +1,48 @@
+#ifndef THESIS_OUTCOMETABLE_H
+#define THESIS_OUTCOMETABLE_H
+
+#include <vector>
+#include <cstdint>
+#include "./Predictor.h"
+
+using namespace std;
+
+// A fixed-size list of overridden match odds, e.g. a match with a forced outcome
+class OutcomePatches {
+public:
+    static const int capacity = 4;
+    int count = 0;
+    int homeTeam[capacity] = {};
+    int awayTeam[capacity] = {};
+    float thresholds[capacity][2] = {};
+    OutcomePatches();
+    OutcomePatches(int homeTeam, int awayTeam, float homeWin, float awayWin);
+    void add(int homeTeam, int awayTeam, float homeWin, float awayWin);
+};
+
+// The predictor compiled into an N x N matrix of cumulative thresholds.
+// Drawing an outcome compares a uniform number against the two thresholds
+// of the pair: below the first is a home win (0), below the second an away win (1), otherwise a draw (2).
+class OutcomeTable {
+public:
+    int numberOfTeams = 0;
+    vector<float> thresholds;
+    OutcomeTable();
+    OutcomeTable(const Predictor& predictor, int numberOfTeams);
+
+    const float* odds(int homeTeam, int awayTeam, const OutcomePatches& patches) const {
+        for(int p = 0; p < patches.count; p++) {
+            if(patches.homeTeam[p] == homeTeam && patches.awayTeam[p] == awayTeam) {
+                return patches.thresholds[p];
+            }
+        }
+        return &thresholds[2 * (homeTeam * numberOfTeams + awayTeam)];
+    }
+    // Thresholds of the matches of rounds start to end, one cell per match in the layout of a scenario
+    void lookup(int** schedule, int start, int end, const OutcomePatches& patches, float* low, float* high) const;
+    // Outcomes of n matches at once, the same as draw with the thresholds low[c] and high[c] of every match
+    static void decide(const float* uniforms, const float* low, const float* high, int8_t* outcomes, int n);
+};
+
+
+#endif //THESIS_OUTCOMETABLE_H
@@ -7,4 +7,15 @@ Predictor::Predictor() {
 
 Predictor::Predictor(Predictor& other) noexcept  {
     this->number = other.number;
-}
\ No newline at end of file
+}
+
+void Predictor::fillThresholds(int numberOfTeams, float* thresholds) const {
+    for(int i = 0; i < numberOfTeams; i++) {
+        for(int j = 0; j < numberOfTeams; j++) {
+            if(i == j) continue;
+            pair<float, float> odds = cumulativeOdds(i, j);
+            thresholds[2 * (i * numberOfTeams + j)] = odds.first;
+            thresholds[2 * (i * numberOfTeams + j) + 1] = odds.second;
+        }
+    }
+}
@@ -1,4 +1,3 @@
-
 #ifndef THESIS_PREDICTOR_H
 #define THESIS_PREDICTOR_H
 
@@ -12,11 +11,16 @@ using namespace std;
 
 class Configuration;
 
+// Match odds of every pair of teams. Outcomes are not drawn here: the odds are compiled once
+// into an OutcomeTable, which samples whole rounds without a virtual call per match
 class Predictor {
 private:
 public:
     int number = 0;
-    virtual int predict(float rng, const vector<int>& index, map<vector<int>, tuple<float, float, float, int>> adaptations) = 0;
+    // Cumulative thresholds (home win, home win + away win) that a uniform draw is compared against
+    virtual pair<float, float> cumulativeOdds(int homeTeam, int awayTeam) const = 0;
+    // Thresholds of all pairs, row-major with two floats per pair. Pairs of a team with itself are left untouched
+    virtual void fillThresholds(int numberOfTeams, float* thresholds) const;
     virtual Predictor* clone() = 0;
     Predictor();
     Predictor(Predictor& other) noexcept;
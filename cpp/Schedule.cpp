@@ -0,0 +1,22 @@
+#include "Schedule.h"
+
+Schedule::Schedule(int rounds, int numberOfTeams) {
+    this->rounds = rounds;
+    this->numberOfTeams = numberOfTeams;
+    teams.assign((size_t) rounds * numberOfTeams, 0);
+    point();
+}
+
+Schedule::Schedule(const Schedule& other) {
+    rounds = other.rounds;
+    numberOfTeams = other.numberOfTeams;
+    teams = other.teams;
+    point();
+}
+
+void Schedule::point() {
+    pointers.resize(rounds);
+    for(int i = 0; i < rounds; i++) {
+        pointers[i] = teams.data() + (size_t) i * numberOfTeams;
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef THESIS_SCHEDULE_H
+#define THESIS_SCHEDULE_H
+
+#include <vector>
+
+using namespace std;
+
+// Teams of every match, one row per round with the home team of game j at 2j and the away team at 2j + 1.
+// rows() is the int** layout the calculations index as schedule[round][2*game]
+class Schedule {
+public:
+    int rounds = 0;
+    int numberOfTeams = 0;
+    Schedule(int rounds, int numberOfTeams);
+    Schedule(const Schedule& other);
+    Schedule& operator=(const Schedule& other) = delete;
+    int** rows() {
+        return pointers.data();
+    }
+private:
+    vector<int> teams;
+    vector<int*> pointers;
+    void point();
+};
+
+
+#endif //THESIS_SCHEDULE_H
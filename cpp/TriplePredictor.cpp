@@ -10,23 +10,12 @@ TriplePredictor::TriplePredictor(TriplePredictor& other)  : Predictor(other) {
     this->teams = other.teams;
 }
 
-int TriplePredictor::predict(float rng, const vector<int>& index, map<vector<int>, tuple<float, float, float, int>> adaptations) {
-    if(adaptations.find(index) != adaptations.end()) {
-        if(rng < get<0>(adaptations[index])) {
-            return 0;
-        }
-        else if(rng < (get<0>(adaptations[index]) + get<1>(adaptations[index]))) {
-            return 1;
-        }
-        return 2;
+pair<float, float> TriplePredictor::cumulativeOdds(int homeTeam, int awayTeam) const {
+    auto odds = teams.find({homeTeam, awayTeam});
+    if(odds == teams.end()) {
+        return make_pair(0.0f, 0.0f);
     }
-    if(rng < get<0>(teams[index])) {
-        return 0;
-    }
-    else if(rng < (get<0>(teams[index]) + get<1>(teams[index]))) {
-        return 1;
-    }
-    return 2;
+    return make_pair(get<0>(odds->second), get<0>(odds->second) + get<1>(odds->second));
 }
 
 Predictor* TriplePredictor::clone() {
@@ -8,7 +8,7 @@ public:
     map<vector<int>, tuple<float, float, float, int>> teams;
     TriplePredictor(map<vector<int>, tuple<float, float, float, int>> teams, int i);
     TriplePredictor(TriplePredictor& other);
-    int predict(float rng, const vector<int>& index, map<vector<int>, tuple<float, float, float, int>> adaptations) override;
+    pair<float, float> cumulativeOdds(int homeTeam, int awayTeam) const override;
     Predictor* clone() override;
     ~TriplePredictor() override;
 };
@@ -0,0 +1,38 @@
+#include "Arena.h"
+#include <algorithm>
+
+Arena::Arena(size_t blockSize) {
+    this->blockSize = blockSize;
+}
+
+void* Arena::allocateBytes(size_t bytes, size_t alignment) {
+    // Blocks come from new[], which is aligned for every fundamental type, so aligning the offset suffices
+    while(current < blocks.size()) {
+        size_t start = (offset + alignment - 1) / alignment * alignment;
+        if(start + bytes <= blocks[current].size) {
+            offset = start + bytes;
+            return blocks[current].data.get() + start;
+        }
+        current++;
+        offset = 0;
+    }
+    size_t size = max(blockSize, bytes);
+    blocks.push_back({unique_ptr<char[]>(new char[size]), size});
+    current = blocks.size() - 1;
+    offset = bytes;
+    return blocks[current].data.get();
+}
+
+void Arena::reset() {
+    current = 0;
+    offset = 0;
+}
+
+Arena::Mark Arena::mark() const {
+    return {current, offset};
+}
+
+void Arena::rewind(const Mark& mark) {
+    current = mark.current;
+    offset = mark.offset;
+}
@@ -0,0 +1,50 @@
+#ifndef THESIS_ARENA_H
+#define THESIS_ARENA_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+// Scratch memory of one calculation. Buffers are cut from large blocks and released all at once by reset,
+// which keeps the blocks, so work that repeats the same requests allocates nothing after its first pass.
+// Not thread safe, buffers are handed out before the work is split across threads
+class Arena {
+public:
+    static constexpr size_t defaultBlockSize = 1 << 20;
+    explicit Arena(size_t blockSize = defaultBlockSize);
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    // A zeroed buffer of count values, valid until the next reset or rewind past it
+    template<typename T>
+    T* allocate(size_t count) {
+        static_assert(is_trivially_copyable<T>::value, "Arena buffers are not constructed or destroyed");
+        void* buffer = allocateBytes(count * sizeof(T), alignof(T));
+        memset(buffer, 0, count * sizeof(T));
+        return static_cast<T*>(buffer);
+    }
+    void reset();
+    // Position of the next buffer. Rewinding to a mark releases every buffer handed out after it
+    struct Mark {
+        size_t current;
+        size_t offset;
+    };
+    Mark mark() const;
+    void rewind(const Mark& mark);
+private:
+    struct Block {
+        unique_ptr<char[]> data;
+        size_t size;
+    };
+    vector<Block> blocks;
+    size_t blockSize;
+    size_t current = 0;
+    size_t offset = 0;
+    void* allocateBytes(size_t bytes, size_t alignment);
+};
+
+
+#endif //THESIS_ARENA_H
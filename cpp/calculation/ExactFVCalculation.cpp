@@ -0,0 +1,201 @@
+#include "ExactFVCalculation.h"
+#include "ScoreBlock.h"
+
+ExactFVCalculation::ExactFVCalculation(const Configuration& config) : FVCalculation() {
+    this->config = config;
+    this->outcomes = OutcomeTable(*this->config.predictor, this->config.numberOfTeams);
+}
+
+map<map<string,string>, list<vector<long double>>> ExactFVCalculation::calculate() {
+    map<map<string,string>, list<vector<long double>>> results;
+    pool = make_shared<ThreadPool>(max(1, threads));
+    int games = config.numberOfTeams / 2;
+    int teams = config.numberOfTeams;
+
+    // Forward pass: the exact score distribution before every round
+    vector<ScoreTable> before(config.rounds + 1);
+    before[0].add(ScoreKey(vector<int>(teams, 0).data(), teams), 1.0);
+    for(int i = 0; i < config.rounds; i++) {
+        before[i + 1] = before[i];
+        for(int j = 0; j < games; j++) {
+            before[i + 1] = propagate(before[i + 1], match(i, j));
+        }
+        before[i].sort();
+    }
+
+    // Backward pass: expected prizes of every state, starting from the final standings
+    ValueTable values;
+    values.states = before[config.rounds];
+    values.values.resize((size_t) values.states.size() * teams);
+    ScoreBlock standings(values.states.size(), teams);
+    for(int e = 0; e < values.states.size(); e++) {
+        values.states.keys[e].unpack(standings.scenario(e), teams);
+    }
+    vector<int> zeros(teams, 0);
+    config.priceFunction->assignPrices(standings, 0, standings.runs, zeros.data(), values.values.data());
+    for(int i = config.rounds - 1; i >= 0; i--) {
+        vector<Match> round(games);
+        for(int j = 0; j < games; j++) {
+            round[j] = match(i, j);
+        }
+        // forcedValues[j] holds the expected prizes after game j of this round was decided, before the other games
+        vector<ValueTable> forcedValues(games);
+        pool->parallelFor(games, [&](int j) {
+            ScoreTable domain;
+            domain.reserve(3 * before[i].size());
+            for(const ScoreKey& key : before[i].keys) {
+                for(int s = 0; s < 3; s++) {
+                    ScoreKey state = key;
+                    state.add(round[j].homeTeam, ScoreBlock::homePoints(s));
+                    state.add(round[j].awayTeam, ScoreBlock::awayPoints(s));
+                    domain.insert(state);
+                }
+            }
+            vector<Match> others;
+            for(int k = 0; k < games; k++) {
+                if(k != j) others.push_back(round[k]);
+            }
+            forcedValues[j] = expectation(domain, others, values);
+        });
+
+        // Unforced expected prizes at the start of the round, used by the previous round
+        ValueTable roundValues;
+        roundValues.states = before[i];
+        roundValues.values.assign((size_t) before[i].size() * teams, 0.0);
+        for(int e = 0; e < before[i].size(); e++) {
+            long double* value = &roundValues.values[(size_t) e * teams];
+            for(int s = 0; s < 3; s++) {
+                ScoreKey state = before[i].keys[e];
+                state.add(round[0].homeTeam, ScoreBlock::homePoints(s));
+                state.add(round[0].awayTeam, ScoreBlock::awayPoints(s));
+                const long double* forced = forcedValues[0].at(state, teams);
+                for(int k = 0; k < teams; k++) {
+                    value[k] += round[0].odds[s] * forced[k];
+                }
+            }
+        }
+
+        for(int j = 0; j < games; j++) {
+            int homeTeam = round[j].homeTeam;
+            int awayTeam = round[j].awayTeam;
+            map<string, string> key = {};
+            key["round"] = to_string(i);
+            key["homeTeam"] = to_string(homeTeam);
+            key["awayTeam"] = to_string(awayTeam);
+            key["game"] = to_string(j);
+            results[key] = list<vector<long double>>{};
+            for(int e = 0; e < before[i].size(); e++) {
+                if(before[i].mass[e] <= 0.0) continue;
+                const long double* _t[4];
+                for(int s = 0; s < 3; s++) {
+                    ScoreKey state = before[i].keys[e];
+                    state.add(homeTeam, ScoreBlock::homePoints(s));
+                    state.add(awayTeam, ScoreBlock::awayPoints(s));
+                    _t[s] = forcedValues[j].at(state, teams);
+                }
+                _t[3] = &roundValues.values[(size_t) e * teams];
+                long double MPh = _t[0][homeTeam] - _t[3][homeTeam];
+                long double MGh = _t[3][homeTeam] - _t[1][homeTeam];
+                long double MPa = _t[1][awayTeam] - _t[3][awayTeam];
+                long double MGa = _t[3][awayTeam] - _t[0][awayTeam];
+                long double FVh = MPh - MGa;
+                long double FVa = MPa - MGh;
+                long double FVd = _t[2][homeTeam] - _t[3][homeTeam] + _t[2][awayTeam] - _t[3][awayTeam];
+                // Exact values have no sampling error, need no runs and keep every state
+                results[key].push_back({
+                    before[i].mass[e], FVh, FVa, FVd, 0.0, 0.0, 0.0, 0.0, 0.0
+                });
+            }
+        }
+        values = std::move(roundValues);
+    }
+    return results;
+}
+
+ExactFVCalculation::Match ExactFVCalculation::match(int round, int game) const {
+    Match match;
+    match.homeTeam = config.schedule[round][2*game];
+    match.awayTeam = config.schedule[round][2*game+1];
+    OutcomePatches none;
+    const float* t = outcomes.odds(match.homeTeam, match.awayTeam, none);
+    match.odds[0] = t[0];
+    match.odds[1] = (long double) t[1] - t[0];
+    match.odds[2] = 1.0L - t[1];
+    return match;
+}
+
+// Distribution after one more match. Outcomes without probability are kept with zero mass,
+// so every state the backward pass can reach is present
+ScoreTable ExactFVCalculation::propagate(const ScoreTable& dist, const Match& match) const {
+    ScoreTable next;
+    next.reserve(3 * dist.size());
+    for(int e = 0; e < dist.size(); e++) {
+        for(int s = 0; s < 3; s++) {
+            ScoreKey state = dist.keys[e];
+            state.add(match.homeTeam, ScoreBlock::homePoints(s));
+            state.add(match.awayTeam, ScoreBlock::awayPoints(s));
+            next.add(state, dist.mass[e] * match.odds[s]);
+        }
+    }
+    checkBudget(next.size());
+    return next;
+}
+
+// Expected prizes of every state in domain after the given matches were played, values holds the prizes afterwards
+ExactFVCalculation::ValueTable ExactFVCalculation::expectation(const ScoreTable& domain, const vector<Match>& matches, const ValueTable& values) const {
+    int teams = config.numberOfTeams;
+    vector<ScoreTable> stages(matches.size() + 1);
+    stages[0] = domain;
+    for(size_t k = 0; k < matches.size(); k++) {
+        stages[k + 1].reserve(3 * stages[k].size());
+        for(const ScoreKey& key : stages[k].keys) {
+            for(int s = 0; s < 3; s++) {
+                ScoreKey next = key;
+                next.add(matches[k].homeTeam, ScoreBlock::homePoints(s));
+                next.add(matches[k].awayTeam, ScoreBlock::awayPoints(s));
+                stages[k + 1].insert(next);
+            }
+        }
+        checkBudget(stages[k + 1].size());
+    }
+    ValueTable current;
+    current.states = std::move(stages[matches.size()]);
+    current.values.resize((size_t) current.states.size() * teams);
+    for(int e = 0; e < current.states.size(); e++) {
+        const long double* value = values.at(current.states.keys[e], teams);
+        copy(value, value + teams, &current.values[(size_t) e * teams]);
+    }
+    for(int k = (int) matches.size() - 1; k >= 0; k--) {
+        ValueTable previous;
+        previous.states = std::move(stages[k]);
+        previous.values.assign((size_t) previous.states.size() * teams, 0.0);
+        for(int e = 0; e < previous.states.size(); e++) {
+            long double* value = &previous.values[(size_t) e * teams];
+            for(int s = 0; s < 3; s++) {
+                ScoreKey next = previous.states.keys[e];
+                next.add(matches[k].homeTeam, ScoreBlock::homePoints(s));
+                next.add(matches[k].awayTeam, ScoreBlock::awayPoints(s));
+                const long double* after = current.at(next, teams);
+                for(int t = 0; t < teams; t++) {
+                    value[t] += matches[k].odds[s] * after[t];
+                }
+            }
+        }
+        current = std::move(previous);
+    }
+    return current;
+}
+
+const long double* ExactFVCalculation::ValueTable::at(const ScoreKey& state, int numberOfTeams) const {
+    int index = states.find(state);
+    if(index < 0) {
+        throw out_of_range("Score state missing from the value table");
+    }
+    return &values[(size_t) index * numberOfTeams];
+}
+
+void ExactFVCalculation::checkBudget(size_t states) const {
+    if((long) states > config.stateBudget) {
+        throw StateBudgetExceeded("Exact calculation needs more than " + to_string(config.stateBudget) + " score states");
+    }
+}
@@ -0,0 +1,48 @@
+#ifndef THESIS_EXACTFVCALCULATION_H
+#define THESIS_EXACTFVCALCULATION_H
+
+#include <memory>
+#include <stdexcept>
+#include "./FVCalculation.h"
+#include "./ScoreTable.h"
+#include "../OutcomeTable.h"
+#include "../helpers/ThreadPool.h"
+
+// Thrown when the number of distinct score states exceeds the state budget
+class StateBudgetExceeded : public runtime_error {
+public:
+    explicit StateBudgetExceeded(const string& message) : runtime_error(message) {}
+};
+
+// Exact fraud values without sampling noise.
+// The score distribution is propagated match by match with identical score vectors merged,
+// and the expected prizes are computed by backward induction from the final standings.
+// The work grows with the number of distinct score states, so it is meant for small leagues.
+class ExactFVCalculation: public FVCalculation {
+private:
+    struct Match {
+        int homeTeam;
+        int awayTeam;
+        long double odds[3];
+    };
+    // Expected prizes of every team, one row of values per state
+    struct ValueTable {
+        ScoreTable states;
+        vector<long double> values;
+        const long double* at(const ScoreKey& state, int numberOfTeams) const;
+    };
+    Match match(int round, int game) const;
+    ScoreTable propagate(const ScoreTable& dist, const Match& match) const;
+    ValueTable expectation(const ScoreTable& domain, const vector<Match>& matches, const ValueTable& values) const;
+    void checkBudget(size_t states) const;
+public:
+    Configuration config;
+    OutcomeTable outcomes;
+    int threads = 1;
+    shared_ptr<ThreadPool> pool;
+    ExactFVCalculation(const Configuration& config);
+    map<map<string,string>, list<vector<long double>>> calculate() override;
+};
+
+
+#endif //THESIS_EXACTFVCALCULATION_H
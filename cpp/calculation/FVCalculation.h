@@ -5,7 +5,9 @@
 #include "../Configuration.h"
 
 class FVCalculation {
+public:
     virtual map<map<string,string>, list<vector<long double>>> calculate() = 0;
+    virtual ~FVCalculation() {};
 };
 
 
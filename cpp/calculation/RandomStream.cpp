@@ -0,0 +1,159 @@
+#include "RandomStream.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define THESIS_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+static const uint32_t PHILOX_M0 = 0xD2511F53;
+static const uint32_t PHILOX_M1 = 0xCD9E8D57;
+static const uint32_t PHILOX_W0 = 0x9E3779B9;
+static const uint32_t PHILOX_W1 = 0xBB67AE85;
+
+RandomStream::RandomStream(uint64_t key) {
+    this->key[0] = (uint32_t) key;
+    this->key[1] = (uint32_t) (key >> 32);
+}
+
+void RandomStream::block(uint64_t run, uint32_t index, uint32_t out[4]) const {
+    uint32_t c0 = index, c1 = 0, c2 = (uint32_t) run, c3 = (uint32_t) (run >> 32);
+    uint32_t k0 = key[0], k1 = key[1];
+    for(int round = 0; round < 10; round++) {
+        uint64_t p0 = (uint64_t) PHILOX_M0 * c0;
+        uint64_t p1 = (uint64_t) PHILOX_M1 * c2;
+        uint32_t n0 = (uint32_t) (p1 >> 32) ^ c1 ^ k0;
+        uint32_t n2 = (uint32_t) (p0 >> 32) ^ c3 ^ k1;
+        c1 = (uint32_t) p1;
+        c3 = (uint32_t) p0;
+        c0 = n0;
+        c2 = n2;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+#ifdef THESIS_X86_KERNELS
+// The vector kernels run the scalar rounds on several counters at once, one block per 64-bit lane
+// with the 32-bit words in the low halves, and return how many whole blocks they wrote
+
+__attribute__((target("avx2")))
+static int fillAvx2(const uint32_t key[2], uint64_t run, float* out, int blocks) {
+    const __m256i low = _mm256_set1_epi64x(0xFFFFFFFF);
+    const __m256i m0 = _mm256_set1_epi64x(PHILOX_M0);
+    const __m256i m1 = _mm256_set1_epi64x(PHILOX_M1);
+    const __m256 scale = _mm256_set1_ps(0x1p-24f);
+    int b = 0;
+    for(; b + 4 <= blocks; b += 4) {
+        __m256i c0 = _mm256_setr_epi64x(b, b + 1, b + 2, b + 3);
+        __m256i c1 = _mm256_setzero_si256();
+        __m256i c2 = _mm256_set1_epi64x((uint32_t) run);
+        __m256i c3 = _mm256_set1_epi64x((uint32_t) (run >> 32));
+        uint32_t k0 = key[0], k1 = key[1];
+        for(int round = 0; round < 10; round++) {
+            __m256i p0 = _mm256_mul_epu32(c0, m0);
+            __m256i p1 = _mm256_mul_epu32(c2, m1);
+            __m256i n0 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p1, 32), c1), _mm256_set1_epi64x(k0));
+            __m256i n2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p0, 32), c3), _mm256_set1_epi64x(k1));
+            c1 = _mm256_and_si256(p1, low);
+            c3 = _mm256_and_si256(p0, low);
+            c0 = n0;
+            c2 = n2;
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+        // Back to the scalar layout, the four words of block b followed by those of block b + 1 and so on
+        __m256i w01 = _mm256_or_si256(c0, _mm256_slli_epi64(c1, 32));
+        __m256i w23 = _mm256_or_si256(c2, _mm256_slli_epi64(c3, 32));
+        __m256i even = _mm256_unpacklo_epi64(w01, w23);
+        __m256i odd = _mm256_unpackhi_epi64(w01, w23);
+        __m256i first = _mm256_permute2x128_si256(even, odd, 0x20);
+        __m256i second = _mm256_permute2x128_si256(even, odd, 0x31);
+        _mm256_storeu_ps(out + 4 * b, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(first, 8)), scale));
+        _mm256_storeu_ps(out + 4 * b + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_srli_epi32(second, 8)), scale));
+    }
+    return b;
+}
+
+// GCC 12 reports the undefined pass-through operand inside its AVX-512 intrinsics as uninitialized
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+__attribute__((target("avx512f")))
+static int fillAvx512(const uint32_t key[2], uint64_t run, float* out, int blocks) {
+    const __m512i low = _mm512_set1_epi64(0xFFFFFFFF);
+    const __m512i m0 = _mm512_set1_epi64(PHILOX_M0);
+    const __m512i m1 = _mm512_set1_epi64(PHILOX_M1);
+    const __m512i firstHalf = _mm512_setr_epi64(0, 8, 1, 9, 2, 10, 3, 11);
+    const __m512i secondHalf = _mm512_setr_epi64(4, 12, 5, 13, 6, 14, 7, 15);
+    const __m512 scale = _mm512_set1_ps(0x1p-24f);
+    int b = 0;
+    for(; b + 8 <= blocks; b += 8) {
+        __m512i c0 = _mm512_setr_epi64(b, b + 1, b + 2, b + 3, b + 4, b + 5, b + 6, b + 7);
+        __m512i c1 = _mm512_setzero_si512();
+        __m512i c2 = _mm512_set1_epi64((uint32_t) run);
+        __m512i c3 = _mm512_set1_epi64((uint32_t) (run >> 32));
+        uint32_t k0 = key[0], k1 = key[1];
+        for(int round = 0; round < 10; round++) {
+            __m512i p0 = _mm512_mul_epu32(c0, m0);
+            __m512i p1 = _mm512_mul_epu32(c2, m1);
+            __m512i n0 = _mm512_xor_si512(_mm512_xor_si512(_mm512_srli_epi64(p1, 32), c1), _mm512_set1_epi64(k0));
+            __m512i n2 = _mm512_xor_si512(_mm512_xor_si512(_mm512_srli_epi64(p0, 32), c3), _mm512_set1_epi64(k1));
+            c1 = _mm512_and_si512(p1, low);
+            c3 = _mm512_and_si512(p0, low);
+            c0 = n0;
+            c2 = n2;
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+        __m512i w01 = _mm512_or_si512(c0, _mm512_slli_epi64(c1, 32));
+        __m512i w23 = _mm512_or_si512(c2, _mm512_slli_epi64(c3, 32));
+        __m512i first = _mm512_permutex2var_epi64(w01, firstHalf, w23);
+        __m512i second = _mm512_permutex2var_epi64(w01, secondHalf, w23);
+        _mm512_storeu_ps(out + 4 * b, _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_srli_epi32(first, 8)), scale));
+        _mm512_storeu_ps(out + 4 * b + 16, _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_srli_epi32(second, 8)), scale));
+    }
+    return b;
+}
+#pragma GCC diagnostic pop
+#endif
+
+// Widest kernel the processor supports, chosen once
+static int fillBlocks(const uint32_t key[2], uint64_t run, float* out, int blocks) {
+#ifdef THESIS_X86_KERNELS
+    static const int width = __builtin_cpu_supports("avx512f") ? 8 : __builtin_cpu_supports("avx2") ? 4 : 1;
+    if(width == 8) return fillAvx512(key, run, out, blocks);
+    if(width == 4) return fillAvx2(key, run, out, blocks);
+#endif
+    return 0;
+}
+
+void RandomStream::fill(uint64_t run, float* out, int n) const {
+    // Whole blocks go through the vector kernels, which produce exactly the scalar numbers
+    int done = fillBlocks(key, run, out, n / 4);
+    uint32_t bits[4];
+    for(int i = 4 * done; i < n; i += 4) {
+        block(run, (uint32_t) (i / 4), bits);
+        for(int j = 0; j < 4 && i + j < n; j++) {
+            out[i + j] = uniform(bits[j]);
+        }
+    }
+}
+
+uint64_t RandomStream::derive(uint64_t key, uint64_t value) {
+    uint64_t z = key + 0x9E3779B97F4A7C15ULL * (value + 1);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+uint64_t RandomStream::hash(const string& value) {
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for(unsigned char c : value) {
+        h ^= c;
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
@@ -0,0 +1,30 @@
+#ifndef THESIS_RANDOMSTREAM_H
+#define THESIS_RANDOMSTREAM_H
+
+#include <cstdint>
+#include <string>
+
+using namespace std;
+
+// Counter-based random numbers (Philox4x32-10).
+// Every draw is a pure function of (key, run, index), so any run can be generated
+// on any thread in any order and still produce exactly the same numbers.
+class RandomStream {
+public:
+    uint32_t key[2];
+    RandomStream(uint64_t key = 0);
+    // Four random words for the given counter
+    void block(uint64_t run, uint32_t index, uint32_t out[4]) const;
+    // The first n uniform floats in [0, 1) of a run
+    void fill(uint64_t run, float* out, int n) const;
+
+    static float uniform(uint32_t bits) {
+        return (float)(bits >> 8) * 0x1p-24f;
+    }
+    // Mix a value into a key, used to give every (configuration, game, strategy) its own stream
+    static uint64_t derive(uint64_t key, uint64_t value);
+    static uint64_t hash(const string& value);
+};
+
+
+#endif //THESIS_RANDOMSTREAM_H
@@ -0,0 +1,21 @@
+#include "RunningStatistics.h"
+#include <cmath>
+#include <limits>
+
+RunningStatistics::RunningStatistics() = default;
+
+void RunningStatistics::add(long double value) {
+    count++;
+    long double delta = value - mean;
+    mean += delta / count;
+    squares += delta * (value - mean);
+}
+
+long double RunningStatistics::variance() const {
+    return count > 1 ? squares / (count - 1) : 0.0;
+}
+
+long double RunningStatistics::standardError() const {
+    if(count < 2) return numeric_limits<long double>::infinity();
+    return sqrt(variance() / count);
+}
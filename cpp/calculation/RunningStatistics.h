@@ -0,0 +1,21 @@
+#ifndef THESIS_RUNNINGSTATISTICS_H
+#define THESIS_RUNNINGSTATISTICS_H
+
+using namespace std;
+
+// Mean and variance of a stream of values, updated one value at a time with Welford's method
+class RunningStatistics {
+public:
+    long count = 0;
+    long double mean = 0.0;
+    RunningStatistics();
+    void add(long double value);
+    long double variance() const;
+    // Standard error of the mean, infinite until there are two values
+    long double standardError() const;
+private:
+    long double squares = 0.0;
+};
+
+
+#endif //THESIS_RUNNINGSTATISTICS_H
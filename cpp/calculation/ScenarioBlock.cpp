@@ -0,0 +1,14 @@
+#include "ScenarioBlock.h"
+
+ScenarioBlock::ScenarioBlock() = default;
+
+ScenarioBlock::ScenarioBlock(int runs, int rounds, int games) {
+    resize(runs, rounds, games);
+}
+
+void ScenarioBlock::resize(int runs, int rounds, int games) {
+    this->runs = runs;
+    this->rounds = rounds;
+    this->games = games;
+    outcomes.assign((size_t)runs * rounds * games, 0);
+}
@@ -0,0 +1,43 @@
+#ifndef THESIS_SCENARIOBLOCK_H
+#define THESIS_SCENARIOBLOCK_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+using namespace std;
+
+// A set of simulated scenarios stored as one contiguous buffer.
+// Outcomes are laid out run-major: [run][round][game], so a single scenario
+// is one contiguous row of rounds * games outcomes (0 home win, 1 away win, 2 draw).
+class ScenarioBlock {
+public:
+    int runs = 0;
+    int rounds = 0;
+    int games = 0;
+    vector<int8_t> outcomes;
+    // Likelihood ratio of every run after every round, [run][round], empty if the runs were sampled from the predictor
+    vector<long double> weights;
+    ScenarioBlock();
+    ScenarioBlock(int runs, int rounds, int games);
+    void resize(int runs, int rounds, int games);
+
+    size_t stride() const {
+        return (size_t)rounds * games;
+    }
+    int8_t* scenario(int run) {
+        return outcomes.data() + (size_t)run * stride();
+    }
+    const int8_t* scenario(int run) const {
+        return outcomes.data() + (size_t)run * stride();
+    }
+    int8_t& at(int run, int round, int game) {
+        return outcomes[(size_t)run * stride() + (size_t)round * games + game];
+    }
+    int at(int run, int round, int game) const {
+        return outcomes[(size_t)run * stride() + (size_t)round * games + game];
+    }
+};
+
+
+#endif //THESIS_SCENARIOBLOCK_H
@@ -0,0 +1,76 @@
+#include "ScoreBlock.h"
+#include "ScoreTable.h"
+
+ScoreBlock::ScoreBlock() = default;
+
+ScoreBlock::ScoreBlock(int runs, int teams) {
+    this->runs = runs;
+    this->teams = teams;
+    points.assign((size_t)runs * teams, 0);
+}
+
+void ScoreBlock::assign(const ScenarioBlock& scenarios, int** schedule, int start, int numberOfTeams) {
+    runs = scenarios.runs;
+    teams = numberOfTeams;
+    points.assign((size_t)runs * teams, 0);
+    weights.clear();
+    for(int r = 0; r < scenarios.runs; r++) {
+        const int8_t* scenario = scenarios.scenario(r);
+        int* score = this->scenario(r);
+        for(int i = 0; i < scenarios.rounds; i++) {
+            const int8_t* round = scenario + (size_t)i * scenarios.games;
+            for(int j = 0; j < scenarios.games; j++) {
+                score[schedule[start + i][2*j]] += homePoints(round[j]);
+                score[schedule[start + i][2*j+1]] += awayPoints(round[j]);
+            }
+        }
+    }
+}
+
+void ScoreBlock::replaceOutcome(int run, int homeTeam, int awayTeam, int from, int to) {
+    int* score = scenario(run);
+    score[homeTeam] += homePoints(to) - homePoints(from);
+    score[awayTeam] += awayPoints(to) - awayPoints(from);
+}
+
+ScoreBlock ScoreBlock::enumerate(const OutcomeTable& outcomes, const OutcomePatches& patches, int** schedule, int start, int end, int numberOfTeams) {
+    // Scenarios ending in the same points are merged after every match, impossible outcomes are dropped
+    ScoreTable tree;
+    tree.add(ScoreKey(vector<int>(numberOfTeams, 0).data(), numberOfTeams), 1.0);
+    for(int i = start; i < end; i++) {
+        for(int j = 0; j < numberOfTeams / 2; j++) {
+            int homeTeam = schedule[i][2*j];
+            int awayTeam = schedule[i][2*j+1];
+            const float* t = outcomes.odds(homeTeam, awayTeam, patches);
+            long double odds[3] = {t[0], (long double) t[1] - t[0], 1.0L - t[1]};
+            ScoreTable next;
+            next.reserve(3 * tree.size());
+            for(int e = 0; e < tree.size(); e++) {
+                for(int s = 0; s < 3; s++) {
+                    if(odds[s] <= 0.0) continue;
+                    ScoreKey points = tree.keys[e];
+                    points.add(homeTeam, homePoints(s));
+                    points.add(awayTeam, awayPoints(s));
+                    next.add(points, tree.mass[e] * odds[s]);
+                }
+            }
+            tree = std::move(next);
+        }
+    }
+    tree.sort();
+    ScoreBlock scores(tree.size(), numberOfTeams);
+    for(int r = 0; r < tree.size(); r++) {
+        tree.keys[r].unpack(scores.scenario(r), numberOfTeams);
+    }
+    scores.weights = tree.mass;
+    return scores;
+}
+
+long ScoreBlock::tailSize(int start, int end, int games, long limit) {
+    long size = 1;
+    for(int k = 0; k < (end - start) * games; k++) {
+        if(size > limit / 3) return limit + 1;
+        size *= 3;
+    }
+    return size;
+}
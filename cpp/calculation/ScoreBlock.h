@@ -0,0 +1,46 @@
+#ifndef THESIS_SCOREBLOCK_H
+#define THESIS_SCOREBLOCK_H
+
+#include <vector>
+#include <cstddef>
+#include "./ScenarioBlock.h"
+#include "../OutcomeTable.h"
+
+using namespace std;
+
+// Points every team gained in each scenario of a block, stored as one runs x teams matrix.
+// Adding a row to a starting score gives the final standings of that scenario.
+class ScoreBlock {
+public:
+    int runs = 0;
+    int teams = 0;
+    vector<int> points;
+    // Probability of every scenario, empty if all scenarios are equally likely
+    vector<long double> weights;
+    ScoreBlock();
+    ScoreBlock(int runs, int teams);
+    // Accumulate the points of the rounds start .. start + scenarios.rounds of every scenario into this block, reusing its buffer
+    void assign(const ScenarioBlock& scenarios, int** schedule, int start, int numberOfTeams);
+    // Every distinct points outcome of the rounds start .. end with its exact probability
+    static ScoreBlock enumerate(const OutcomeTable& outcomes, const OutcomePatches& patches, int** schedule, int start, int end, int numberOfTeams);
+    // Number of outcomes of the matches in the rounds start .. end, or limit + 1 if there are more than limit
+    static long tailSize(int start, int end, int games, long limit);
+    // Replace the result of one match in one scenario
+    void replaceOutcome(int run, int homeTeam, int awayTeam, int from, int to);
+
+    static int homePoints(int outcome) {
+        return outcome == 0 ? 3 : (outcome == 2 ? 1 : 0);
+    }
+    static int awayPoints(int outcome) {
+        return outcome == 1 ? 3 : (outcome == 2 ? 1 : 0);
+    }
+    int* scenario(int run) {
+        return points.data() + (size_t)run * teams;
+    }
+    const int* scenario(int run) const {
+        return points.data() + (size_t)run * teams;
+    }
+};
+
+
+#endif //THESIS_SCOREBLOCK_H
@@ -0,0 +1,38 @@
+#include "ScoreKey.h"
+#include <stdexcept>
+#include <string>
+
+ScoreKey::ScoreKey() = default;
+
+ScoreKey::ScoreKey(const int* score, int numberOfTeams) {
+    if(numberOfTeams > maxTeams) {
+        throw runtime_error("Error: at most " + to_string(maxTeams) + " teams are supported, got " + to_string(numberOfTeams));
+    }
+    for(int i = 0; i < numberOfTeams; i++) {
+        add(i, score[i]);
+    }
+}
+
+void ScoreKey::add(int team, int points) {
+    int score = at(team) + points;
+    if(score < 0 || score > maxPoints) {
+        throw runtime_error("Error: score " + to_string(score) + " of team " + to_string(team) + " does not fit into a score key");
+    }
+    word[team >> 3] += (uint64_t) points << shift(team);
+}
+
+void ScoreKey::unpack(int* score, int numberOfTeams) const {
+    for(int i = 0; i < numberOfTeams; i++) {
+        score[i] = at(i);
+    }
+}
+
+uint64_t ScoreKey::hash() const {
+    uint64_t h = 0x9e3779b97f4a7c15ULL;
+    for(int w = 0; w < words; w++) {
+        h ^= word[w];
+        h *= 0xbf58476d1ce4e5b9ULL;
+        h ^= h >> 31;
+    }
+    return h;
+}
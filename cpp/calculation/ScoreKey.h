@@ -0,0 +1,46 @@
+#ifndef THESIS_SCOREKEY_H
+#define THESIS_SCOREKEY_H
+
+#include <cstdint>
+
+using namespace std;
+
+// The points of all teams packed one byte per team into a fixed number of words.
+// Team 0 is stored in the highest byte of the first word, so comparing keys word by word
+// orders them like the score vectors they represent.
+class ScoreKey {
+public:
+    static const int maxTeams = 32;
+    static const int maxPoints = 255;
+    static const int words = maxTeams / 8;
+    uint64_t word[words] = {};
+    ScoreKey();
+    ScoreKey(const int* score, int numberOfTeams);
+    // Add points to one team, throws if the score no longer fits into a byte
+    void add(int team, int points);
+    void unpack(int* score, int numberOfTeams) const;
+    uint64_t hash() const;
+
+    int at(int team) const {
+        return (int) ((word[team >> 3] >> shift(team)) & 0xff);
+    }
+    bool operator==(const ScoreKey& other) const {
+        for(int w = 0; w < words; w++) {
+            if(word[w] != other.word[w]) return false;
+        }
+        return true;
+    }
+    bool operator<(const ScoreKey& other) const {
+        for(int w = 0; w < words; w++) {
+            if(word[w] != other.word[w]) return word[w] < other.word[w];
+        }
+        return false;
+    }
+private:
+    static int shift(int team) {
+        return 56 - 8 * (team & 7);
+    }
+};
+
+
+#endif //THESIS_SCOREKEY_H
@@ -0,0 +1,100 @@
+#include "ScoreTable.h"
+#include <algorithm>
+#include <numeric>
+
+ScoreTable::ScoreTable() = default;
+
+int ScoreTable::find(const ScoreKey& key) const {
+    if(slots.empty()) return -1;
+    for(size_t slot = key.hash() & mask; ; slot = (slot + 1) & mask) {
+        int index = slots[slot];
+        if(index < 0) return -1;
+        if(keys[index] == key) return index;
+    }
+}
+
+int ScoreTable::insert(const ScoreKey& key) {
+    // Keep the load factor at most one half
+    if(2 * (keys.size() + 1) > slots.size()) {
+        rehash(max((size_t) 16, 2 * slots.size()));
+    }
+    size_t slot = key.hash() & mask;
+    for(; slots[slot] >= 0; slot = (slot + 1) & mask) {
+        if(keys[slots[slot]] == key) return slots[slot];
+    }
+    slots[slot] = (int) keys.size();
+    keys.push_back(key);
+    mass.push_back(0.0);
+    return slots[slot];
+}
+
+void ScoreTable::reserve(int count) {
+    keys.reserve(count);
+    mass.reserve(count);
+    size_t capacity = 16;
+    while(capacity < 2 * (size_t) count) capacity *= 2;
+    if(capacity > slots.size()) rehash(capacity);
+}
+
+void ScoreTable::sort() {
+    vector<int> order(keys.size());
+    iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](int a, int b) { return keys[a] < keys[b]; });
+    vector<ScoreKey> sortedKeys(keys.size());
+    vector<long double> sortedMass(mass.size());
+    for(size_t i = 0; i < order.size(); i++) {
+        sortedKeys[i] = keys[order[i]];
+        sortedMass[i] = mass[order[i]];
+    }
+    keys = std::move(sortedKeys);
+    mass = std::move(sortedMass);
+    rehash(slots.size());
+}
+
+ScoreTable ScoreTable::truncated(long double keep, long double& discarded) const {
+    vector<int> order(keys.size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [this](int a, int b) { return mass[a] > mass[b]; });
+    vector<bool> kept(keys.size(), false);
+    long double total = 0.0;
+    for(int index : order) {
+        if(total >= keep) break;
+        kept[index] = true;
+        total += mass[index];
+    }
+    ScoreTable table;
+    table.reserve((int) keys.size());
+    for(size_t i = 0; i < keys.size(); i++) {
+        if(kept[i]) table.add(keys[i], mass[i]);
+        else discarded += mass[i];
+    }
+    return table;
+}
+
+ScoreTable ScoreTable::shifted(int numberOfTeams) const {
+    ScoreTable table;
+    table.reserve((int) keys.size());
+    for(size_t i = 0; i < keys.size(); i++) {
+        int lowest = ScoreKey::maxPoints;
+        for(int t = 0; t < numberOfTeams; t++) {
+            lowest = min(lowest, keys[i].at(t));
+        }
+        ScoreKey key = keys[i];
+        for(int t = 0; t < numberOfTeams; t++) {
+            key.add(t, -lowest);
+        }
+        table.add(key, mass[i]);
+    }
+    table.sort();
+    return table;
+}
+
+void ScoreTable::rehash(size_t capacity) {
+    slots.assign(capacity, -1);
+    mask = capacity - 1;
+    for(size_t i = 0; i < keys.size(); i++) {
+        size_t slot = keys[i].hash() & mask;
+        while(slots[slot] >= 0) slot = (slot + 1) & mask;
+        slots[slot] = (int) i;
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef THESIS_SCORETABLE_H
+#define THESIS_SCORETABLE_H
+
+#include <vector>
+#include "./ScoreKey.h"
+
+using namespace std;
+
+// A distribution over score states.
+// Keys and their probability mass are stored densely in insertion order, an open-addressing index
+// with linear probing maps a key to its position, so iterating the states is a plain array walk.
+class ScoreTable {
+public:
+    vector<ScoreKey> keys;
+    vector<long double> mass;
+    ScoreTable();
+    int size() const {
+        return (int) keys.size();
+    }
+    // Position of the key, or -1 if it is not in the table
+    int find(const ScoreKey& key) const;
+    // Position of the key, new keys are appended with zero mass
+    int insert(const ScoreKey& key);
+    void add(const ScoreKey& key, long double weight) {
+        mass[insert(key)] += weight;
+    }
+    void reserve(int count);
+    // Order the states by their score vectors
+    void sort();
+    // The most probable states that together hold at least the given mass, in the order of this table.
+    // The mass of the states left out is added to discarded
+    ScoreTable truncated(long double keep, long double& discarded) const;
+    // States shifted so the last team has 0 points, merging states that only differ by the same points for every team
+    ScoreTable shifted(int numberOfTeams) const;
+private:
+    vector<int> slots;
+    size_t mask = 0;
+    void rehash(size_t capacity);
+};
+
+
+#endif //THESIS_SCORETABLE_H
@@ -1,98 +1,141 @@
 #include "SimulatedFVCalculation.h"
+#include <array>
+#include <cmath>
 
 SimulatedFVCalculation::SimulatedFVCalculation(const Configuration& config) : FVCalculation() {
     this->config = config;
+    this->outcomes = OutcomeTable(*this->config.predictor, this->config.numberOfTeams);
 }
 
 map<map<string,string>, list<vector<long double>>> SimulatedFVCalculation::calculate() {
     map<map<string,string>, list<vector<long double>>> results;
-    map<vector<int>, long double> opportunityCosts;
-    int*** initialRuns = run(config.preRuns > 0 ? config.preRuns : runs);
-    map<vector<int>, map<vector<int>, long double>> table = calculateTable(initialRuns, config.preRuns);
-
+    pool = make_shared<ThreadPool>(max(1, threads));
+    int initialAmount = config.preRuns > 0 ? config.preRuns : runs;
+    ScenarioBlock initialRuns;
+    if(config.importance > 0) {
+        initialRuns = runTilted(initialAmount, stream(-1, 0), config.importance);
+    }
+    else {
+        run(initialRuns, initialAmount, stream(-1, 0));
+    }
+    vector<ScoreTable> table = calculateTable(initialRuns);
+    ScoreTable initial;
+    initial.add(ScoreKey(vector<int>(config.numberOfTeams, 0).data(), config.numberOfTeams), 1.0);
+    // Prizes only depend on the ranking, so states that differ by the same points for every team have the same fraud values.
+    // The least probable states can be left out, their mass is reported with every row
+    vector<long double> discarded(config.rounds, 0.0);
     for(int i = 0; i < config.rounds; i++) {
-        vector<int> index = {0, i};
-        map<vector<int>, long double> dist  = table[index];
+        if(config.distMerge) {
+            table[i] = table[i].shifted(config.numberOfTeams);
+        }
+        if(config.distMass < 1.0) {
+            table[i] = table[i].truncated(config.distMass, discarded[i]);
+        }
     }
 
+    int teams = config.numberOfTeams;
+    // Points every team gains over the rest of the season, per scenario and collusion strategy, reused by every game
+    ScoreBlock deltas[4];
     for(int i = 0; i < config.rounds; i++) {
         for(int j = 0; j < config.numberOfTeams / 2; j++) {
+            arena.reset();
             map<string, string> key = {};
             key["round"] = to_string(i);
             key["homeTeam"] = to_string(config.schedule[i][2*j]);
             key["awayTeam"] = to_string(config.schedule[i][2*j+1]);
             key["game"] = to_string(j);
             results[key] = list<vector<long double>>{};
-            auto start = std::chrono::high_resolution_clock::now();
-            int*** _runs[] = {
-                    run(config.postRuns, {
-                            {
-                                    {
-                                            config.schedule[i][2*j],
-                                            config.schedule[i][2*j+1]
-                                    },
-                                    make_tuple(1.0,0.0,0.0,0)
-                            }
-                    }, i, config.rounds),
-                    run(config.postRuns, {
-                            {
-                                    {
-                                            config.schedule[i][2*j],
-                                            config.schedule[i][2*j+1]
-                                    },
-                                    make_tuple(0.0,1.0,0.0,0)
-                            }
-                    }, i, config.rounds),
-                    run(config.postRuns, {
-                            {
-                                    {
-                                            config.schedule[i][2*j],
-                                            config.schedule[i][2*j+1]
-                                    },
-                                    make_tuple(0.0,0.0,1.0,0)
-                            }
-                    }, i, config.rounds),
-                    run(config.postRuns, {}, i, config.rounds)
-            };
-            map<vector<int>, long double> dist;
-            // If the round is the first round, set the distribution to 100% for the initial score of 0 for all teams
-            if(i < 1) {
-                dist = {
-                        {
-                                vector<int>(config.numberOfTeams, 0),
-                                1.0
-                        }
-                };
-            }
-            // If the round is not the first round, set the distribution to the previous round's distribution
-            else {
-                vector<int> index = {0,i-1};
-                dist = table[index];
-            }
-            
+            int homeTeam = config.schedule[i][2*j];
+            int awayTeam = config.schedule[i][2*j+1];
+            // The first round starts from 0 points for all teams, later rounds from the previous round's distribution
+            const ScoreTable& dist = i < 1 ? initial : table[i-1];
+
             // Check that sum of probabilities equals 1.0
-            long double sum = 0.0;
-            for (const auto& pair : dist) {
-                sum += pair.second;
+            long double sum = i < 1 ? 0.0 : discarded[i-1];
+            for (long double mass : dist.mass) {
+                sum += mass;
             }
             if (abs(sum - 1.0) > 1e-6) {
                 throw runtime_error("Sum of probabilities in dist is not 1.0. Sum = " + to_string(sum) + 
                                    " for Round " + to_string(i) + ", Game " + to_string(j));
             }
-            // Calculate the EV for each team for each scenario
-            auto** ev = new long double*[config.numberOfTeams];
-            for(int k = 0; k < config.numberOfTeams; k++) {
-                ev[k] = new long double[4];
+            bool enumerated = ScoreBlock::tailSize(i, config.rounds, config.numberOfTeams / 2, config.tailEnumeration) <= config.tailEnumeration;
+            // Change in EV for each score state and collusion strategy, averaged over all batches, [state][strategy][team]
+            long double* evs = arena.allocate<long double>((size_t) dist.size() * 4 * teams);
+            // Fraud values of the whole game per run, used to decide when the estimate is precise enough
+            RunningStatistics errors[3];
+            // Only a target error needs the per run prices, they take chunks x 4 x 2 values per run
+            bool measured = !enumerated && config.targetError > 0;
+            // EVs of the latest batch, only a target error runs more than one
+            long double* batch = measured ? arena.allocate<long double>((size_t) dist.size() * 4 * teams) : nullptr;
+            // The buffers of a batch are released before the next one, so memory does not grow with maxRuns
+            Arena::Mark batchStart = arena.mark();
+            int used = 0;
+            while(true) {
+                arena.rewind(batchStart);
+                // The points gained do not depend on the starting score, so they are computed once per batch
+                if(enumerated) {
+                    // Few outcomes remain, enumerate all of them with their exact probability instead of sampling
+                    pool->parallelFor(4, [&](int s) {
+                        deltas[s] = ScoreBlock::enumerate(outcomes, forcedOutcome(homeTeam, awayTeam, s), config.schedule, i, config.rounds, config.numberOfTeams);
+                    });
+                }
+                else {
+                    int count = config.targetError > 0 ? min(config.postRuns, config.maxRuns - used) : config.postRuns;
+                    simulateDeltas(i, j, used, count, deltas);
+                }
+                int count = deltas[3].runs;
+
+                // Calculate the change in EV for each score state and each collusion strategy, one chunk of states per task.
+                // With a target error, sampled runs also sum the prizes of the two teams weighted by the state probability, per run and strategy
+                int chunks = min(stateChunks, dist.size());
+                double* runPrices = !measured ? nullptr : arena.allocate<double>((size_t) chunks * 4 * count * 2);
+                long double* target = used == 0 ? evs : batch;
+                if(used > 0) {
+                    fill(batch, batch + (size_t) dist.size() * 4 * teams, 0.0L);
+                }
+                int* startingScores = arena.allocate<int>((size_t) chunks * teams);
+                long double* prices = arena.allocate<long double>((size_t) chunks * priceBatch * teams);
+                pool->parallelFor(chunks, [&](int c) {
+                    int* startingScore = startingScores + (size_t) c * teams;
+                    for(int e = c * dist.size() / chunks; e < (c + 1) * dist.size() / chunks; e++) {
+                        dist.keys[e].unpack(startingScore, teams);
+                        for(int s = 0; s < 4; s++) {
+                            double* statePrices = !measured ? nullptr : &runPrices[(size_t) (c * 4 + s) * count * 2];
+                            calculateEV(deltas[s], startingScore, homeTeam, awayTeam, dist.mass[e], statePrices,
+                                        prices + (size_t) c * priceBatch * teams, target + ((size_t) e * 4 + s) * teams);
+                        }
+                    }
+                });
+                if(measured) {
+                    for(int r = 0; r < count; r++) {
+                        long double A[4][2] = {};
+                        for(int c = 0; c < chunks; c++) {
+                            for(int s = 0; s < 4; s++) {
+                                A[s][0] += runPrices[((size_t) (c * 4 + s) * count + r) * 2];
+                                A[s][1] += runPrices[((size_t) (c * 4 + s) * count + r) * 2 + 1];
+                            }
+                        }
+                        errors[0].add(A[0][0] - A[3][0] - (A[3][1] - A[0][1]));
+                        errors[1].add(A[1][1] - A[3][1] - (A[3][0] - A[1][0]));
+                        errors[2].add(A[2][0] - A[3][0] + A[2][1] - A[3][1]);
+                    }
+                }
+                if(used > 0) {
+                    for(size_t k = 0; k < (size_t) dist.size() * 4 * teams; k++) {
+                        evs[k] = (evs[k] * used + batch[k] * count) / (used + count);
+                    }
+                }
+                used += count;
+                if(enumerated || config.targetError <= 0 || used >= config.maxRuns) break;
+                if(errors[0].standardError() <= config.targetError && errors[1].standardError() <= config.targetError && errors[2].standardError() <= config.targetError) break;
             }
-            long double PFV = 0.0;
-            auto* SEV = new long double[4];
-            for (const auto& pair : dist) {
-                // Calculate the change in EV for each team for each scenario and each collusion strategy
-                auto _t = new long double*[4];
-                _t[0] = calculateEV(_runs[0], config.postRuns, i, config.rounds, pair.first);
-                _t[1] = calculateEV(_runs[1], config.postRuns, i, config.rounds, pair.first);
-                _t[2] = calculateEV(_runs[2], config.postRuns, i, config.rounds, pair.first);
-                _t[3] = calculateEV(_runs[3], config.postRuns, i, config.rounds, pair.first);
+
+            for (int e = 0; e < dist.size(); e++) {
+                const long double* _t[4];
+                for(int s = 0; s < 4; s++) {
+                    _t[s] = evs + ((size_t) e * 4 + s) * teams;
+                }
                 long double MPh = _t[0][config.schedule[i][2*j]] - _t[3][config.schedule[i][2*j]];
                 long double MGh = _t[3][config.schedule[i][2*j]] - _t[1][config.schedule[i][2*j]];
                 long double MPa = _t[1][config.schedule[i][2*j+1]] - _t[3][config.schedule[i][2*j+1]];
@@ -106,29 +149,16 @@ map<map<string,string>, list<vector<long double>>> SimulatedFVCalculation::calcu
                 key3["homeTeam"] = to_string(config.schedule[i][2*j]);
                 key3["awayTeam"] = to_string(config.schedule[i][2*j+1]);
                 key3["game"] = to_string(j);
+                // Enumerated tails have no sampling error, without a target error it is not measured
+                long double unmeasured = enumerated ? 0.0L : NAN;
                 results[key3].push_back({
-                    pair.second, FVh, FVa, FVd
+                    dist.mass[e], FVh, FVa, FVd,
+                    measured ? errors[0].standardError() : unmeasured,
+                    measured ? errors[1].standardError() : unmeasured,
+                    measured ? errors[2].standardError() : unmeasured,
+                    (long double) used,
+                    i < 1 ? 0.0L : discarded[i-1]
                 });
-
-                for(int k = 0; k < config.numberOfTeams; k++) {
-                    for(int l = 0; l < 4; l++) {
-                        ev[k][l] += pair.second * _t[l][k];
-                    }
-                }
-            }
-            auto end = std::chrono::high_resolution_clock::now();
-            std::chrono::duration<double, std::nano> iteration_duration = end - start;
-            double duration_in_minutes = iteration_duration.count() / (60.0 * 1e9);
-            vector<int> index = {i,j};
-            opportunityCosts[index] = PFV;
-            for(int _i = 0; _i < 4; _i++) {
-                for(int _j = 0; _j < config.postRuns; _j++) {
-                    for(int _k = 0; _k < config.rounds - i; _k++) {
-                        delete _runs[_i][_j][_k];
-                    }
-                    delete _runs[_i][_j];
-                }
-                delete _runs[_i];
             }
         }
     }
@@ -136,75 +166,213 @@ map<map<string,string>, list<vector<long double>>> SimulatedFVCalculation::calcu
     return results;
 }
 
-// Run the simulation and get a number of scenarios
-int*** SimulatedFVCalculation::run(int _runs, map<vector<int>, tuple<float, float, float, int>> adaptations, int start, int end) {
+// Outcome patch forcing strategy s (0 home win, 1 away win, 2 draw) of a match, strategy 3 leaves the match to chance
+OutcomePatches SimulatedFVCalculation::forcedOutcome(int homeTeam, int awayTeam, int strategy) {
+    switch(strategy) {
+        case 0: return OutcomePatches(homeTeam, awayTeam, 1.0, 0.0);
+        case 1: return OutcomePatches(homeTeam, awayTeam, 0.0, 1.0);
+        case 2: return OutcomePatches(homeTeam, awayTeam, 0.0, 0.0);
+        default: return OutcomePatches();
+    }
+}
+
+// Simulate the runs first .. first + count of the rest of the season after game j of round i, for every collusion strategy
+void SimulatedFVCalculation::simulateDeltas(int i, int j, int first, int count, ScoreBlock deltas[4]) {
+    int game = i * (config.numberOfTeams / 2) + j;
+    int homeTeam = config.schedule[i][2*j];
+    int awayTeam = config.schedule[i][2*j+1];
+    if(config.estimator == "common") {
+        // Common random numbers: simulate the rest of the season once and only force the outcome of this game,
+        // so the strategies differ in that single match and their differences have far less variance
+        run(seasons, count, stream(game, 3), OutcomePatches(), i, config.rounds, first);
+        deltas[3].assign(seasons, config.schedule, i, config.numberOfTeams);
+        for(int s = 0; s < 3; s++) {
+            deltas[s] = deltas[3];
+            for(int r = 0; r < seasons.runs; r++) {
+                deltas[s].replaceOutcome(r, homeTeam, awayTeam, seasons.at(r, 0, j), s);
+            }
+        }
+    }
+    else {
+        for(int s = 0; s < 4; s++) {
+            run(seasons, count, stream(game, s), forcedOutcome(homeTeam, awayTeam, s), i, config.rounds, first);
+            deltas[s].assign(seasons, config.schedule, i, config.numberOfTeams);
+        }
+    }
+}
+
+// Run the simulation into scenarios, a number of runs numbered from first in the random stream
+void SimulatedFVCalculation::run(ScenarioBlock& scenarios, int _runs, uint64_t stream, const OutcomePatches& patches, int start, int end, int first) {
     int _end = end;
     if(_end < 0) _end = config.rounds;
-    uniform_real_distribution<float> uniform(0, 1);
-    int*** scenario = new int**[_runs];
-    for(int i = 0; i < _runs; i++) {
-        scenario[i] = new int*[_end - start];
-        for(int j = start; j < _end; j++) {
-            scenario[i][j - start] = new int[config.numberOfTeams / 2];
-            for(int k = 0; k < config.numberOfTeams / 2; k++) {
-                float randomNumber = uniform(*config.rng);
-                int homeTeam = config.schedule[j][2*k];
-                int awayTeam = config.schedule[j][2*k+1];
-                vector<int> index = {homeTeam, awayTeam};
-                float homeWinOdds = get<0>(config.teams[index]);
-                float awayWinnOdds = get<1>(config.teams[index]);
-                scenario[i][j - start][k] = config.predictor->predict(randomNumber, index, adaptations);
+    scenarios.resize(_runs, _end - start, config.numberOfTeams / 2);
+    unique_ptr<Sampler> sampler = Sampler::create(config.sampler, stream);
+    // The thresholds are the same for every run, so they are looked up once in the layout of a scenario
+    float* low = arena.allocate<float>(scenarios.stride());
+    float* high = arena.allocate<float>(scenarios.stride());
+    outcomes.lookup(config.schedule, start, _end, patches, low, high);
+    int blocks = (_runs + runBlock - 1) / runBlock;
+    float* uniforms = arena.allocate<float>((size_t) blocks * scenarios.stride());
+    pool->parallelFor(blocks, [&](int block) {
+        float* blockUniforms = uniforms + (size_t) block * scenarios.stride();
+        int last = min(_runs, (block + 1) * runBlock);
+        for(int i = block * runBlock; i < last; i++) {
+            sampler->fill(first + i, blockUniforms, (int) scenarios.stride(), scenarios.games);
+            OutcomeTable::decide(blockUniforms, low, high, scenarios.scenario(i), (int) scenarios.stride());
+        }
+    });
+}
+
+// Run whole seasons with the match odds tilted toward results that keep the title race close,
+// so close standings are visited more often. Every match is drawn with the probabilities
+// q(s) ~ p(s) * exp(-tilt * (gap after s - gap before) / 3), where gap is the lead of the first over the third team,
+// and the likelihood ratio p / q of every run is kept per round to weight the runs in calculateTable
+ScenarioBlock SimulatedFVCalculation::runTilted(int _runs, uint64_t stream, long double tilt) {
+    ScenarioBlock scenarios(_runs, config.rounds, config.numberOfTeams / 2);
+    scenarios.weights.assign((size_t) _runs * config.rounds, 1.0);
+    unique_ptr<Sampler> sampler = Sampler::create(config.sampler, stream);
+    OutcomePatches none;
+    int blocks = (_runs + runBlock - 1) / runBlock;
+    pool->parallelFor(blocks, [&](int block) {
+        vector<float> uniforms(scenarios.stride());
+        vector<int> score(config.numberOfTeams);
+        int last = min(_runs, (block + 1) * runBlock);
+        for(int i = block * runBlock; i < last; i++) {
+            sampler->fill(i, uniforms.data(), (int) uniforms.size(), scenarios.games);
+            int8_t* scenario = scenarios.scenario(i);
+            fill(score.begin(), score.end(), 0);
+            long double weight = 1.0;
+            for(int j = 0; j < config.rounds; j++) {
+                for(int k = 0; k < config.numberOfTeams / 2; k++) {
+                    int homeTeam = config.schedule[j][2*k];
+                    int awayTeam = config.schedule[j][2*k+1];
+                    const float* t = outcomes.odds(homeTeam, awayTeam, none);
+                    long double p[3] = {t[0], (long double) t[1] - t[0], 1.0L - t[1]};
+                    long double q[3];
+                    long double total = 0.0;
+                    int before = leaderGap(score.data());
+                    for(int s = 0; s < 3; s++) {
+                        score[homeTeam] += ScoreBlock::homePoints(s);
+                        score[awayTeam] += ScoreBlock::awayPoints(s);
+                        q[s] = p[s] * exp(-tilt * (leaderGap(score.data()) - before) / 3.0L);
+                        score[homeTeam] -= ScoreBlock::homePoints(s);
+                        score[awayTeam] -= ScoreBlock::awayPoints(s);
+                        total += q[s];
+                    }
+                    for(int s = 0; s < 3; s++) {
+                        q[s] /= total;
+                    }
+                    int cell = j * scenarios.games + k;
+                    int outcome = (uniforms[cell] >= q[0]) + (uniforms[cell] >= q[0] + q[1]);
+                    // A rounding step may land on an outcome without probability, fall back to the most likely one
+                    if(q[outcome] <= 0.0) {
+                        outcome = (int) (max_element(q, q + 3) - q);
+                    }
+                    scenario[cell] = (int8_t) outcome;
+                    weight *= p[outcome] / q[outcome];
+                    score[homeTeam] += ScoreBlock::homePoints(outcome);
+                    score[awayTeam] += ScoreBlock::awayPoints(outcome);
+                }
+                scenarios.weights[(size_t) i * config.rounds + j] = weight;
             }
         }
+    });
+    return scenarios;
+}
+
+// Points between the leader and the last of the contenders, the measure of how close the title race is
+int SimulatedFVCalculation::leaderGap(const int* score) const {
+    int top[contenders];
+    fill(top, top + contenders, 0);
+    for(int t = 0; t < config.numberOfTeams; t++) {
+        int points = score[t];
+        for(int k = 0; k < contenders; k++) {
+            if(points > top[k]) swap(points, top[k]);
+        }
     }
-    return scenario;
+    return top[0] - top[min(contenders, config.numberOfTeams) - 1];
+}
+
+// Random stream of one game and collusion strategy, game -1 is the initial season simulation
+uint64_t SimulatedFVCalculation::stream(int game, int strategy) const {
+    uint64_t key = RandomStream::derive(seed, RandomStream::hash(config.id));
+    key = RandomStream::derive(key, (uint64_t) game);
+    return RandomStream::derive(key, (uint64_t) strategy);
 }
 
-// Calculate the table of probabilities of each score distribution
-map<vector<int>, map<vector<int>, long double>> SimulatedFVCalculation::calculateTable(int*** scenarios, int amount) const {
-    map<vector<int>, map<vector<int>, long double>> table;
-    auto* ev = new double[config.numberOfTeams];
+// Calculate the table of probabilities of each score distribution, one distribution per round sorted by score.
+// Weighted runs count with their likelihood ratio
+vector<ScoreTable> SimulatedFVCalculation::calculateTable(const ScenarioBlock& scenarios) const {
+    vector<ScoreTable> table(config.rounds);
+    int amount = scenarios.runs;
     for(int i = 0; i < amount; i++) {
-        vector<int> points(config.numberOfTeams, 0);
+        const int8_t* scenario = scenarios.scenario(i);
+        ScoreKey points;
         for(int j = 0; j < config.rounds; j++) {
+            const int8_t* round = scenario + (size_t)j * scenarios.games;
             for(int k = 0; k < config.numberOfTeams / 2; k++) {
-                if(scenarios[i][j][k] == 0) {
-                    points[config.schedule[j][2*k]] += 3;
-                }
-                else if(scenarios[i][j][k] == 1) {
-                    points[config.schedule[j][2*k+1]] += 3;
-                }
-                else if(scenarios[i][j][k] == 2) {
-                    points[config.schedule[j][2*k]] += 1;
-                    points[config.schedule[j][2*k+1]] += 1;
-                }
+                points.add(config.schedule[j][2*k], ScoreBlock::homePoints(round[k]));
+                points.add(config.schedule[j][2*k+1], ScoreBlock::awayPoints(round[k]));
+            }
+            if(scenarios.weights.empty()) {
+                table[j].add(points, 1 / (float) amount);
             }
-            vector<int> index = {0,j};
-            if(table.find(index) == table.end()) {
-                table[index] = {};
+            else {
+                table[j].add(points, scenarios.weights[(size_t) i * config.rounds + j]);
+            }
+        }
+    }
+    // Importance sampled runs are normalized by the sum of their likelihood ratios per round
+    if(!scenarios.weights.empty()) {
+        for(ScoreTable& dist : table) {
+            long double total = 0.0;
+            for(long double mass : dist.mass) {
+                total += mass;
             }
-            if(table[index].find(points) == table[index].end()) {
-                table[index][points] = 0.0;
+            for(long double& mass : dist.mass) {
+                mass /= total;
             }
-            table[index][points] += 1 / (float) amount;
         }
     }
+    for(ScoreTable& dist : table) {
+        dist.sort();
+    }
     return table;
 }
 
-// Calculate the Expected value for each team for each scenario
-long double* SimulatedFVCalculation::calculateEV(int*** scenarios, int amount, int start, int end, vector<int> staringScore) const {
-    int _end = end;
-    if(_end < 0) _end = config.rounds;
-    vector<int> zeros(config.numberOfTeams, 0);
-    if(staringScore.empty()) staringScore = zeros;
-    auto* ev = new long double[config.numberOfTeams];
-    for(int i = 0; i < amount; i++) {
-        long double* scenarioPrice = config.priceFunction->assignPrice(scenarios[i], start, _end, staringScore);
-        for(int j = 0; j < config.numberOfTeams; j++) {
-            ev[j] += scenarioPrice[j] / (double) amount;
+// Calculate the Expected value for each team, starting from the given score and adding the points of every scenario.
+// Scenarios are weighted by their probability if the block has weights, otherwise equally.
+// If runPrices is given, mass times the prizes of the home and away team of every run are added to it.
+// The EVs are added to the zeroed ev, prices is scratch space for priceBatch rows of prizes
+void SimulatedFVCalculation::calculateEV(const ScoreBlock& deltas, const int* startingScore, int homeTeam, int awayTeam, long double mass, double* runPrices, long double* prices, long double* ev) const {
+    dispatchTeams(config.numberOfTeams, [&](auto teams) {
+        calculateEVFor<decltype(teams)::value>(deltas, startingScore, homeTeam, awayTeam, mass, runPrices, prices, ev);
+    });
+}
+
+template<int N>
+void SimulatedFVCalculation::calculateEVFor(const ScoreBlock& deltas, const int* startingScore, int homeTeam, int awayTeam, long double mass, double* runPrices, long double* prices, long double* ev) const {
+    const int teams = TeamCount<N>::size(config.numberOfTeams);
+    int amount = deltas.runs;
+    for(int first = 0; first < amount; first += priceBatch) {
+        int last = min(amount, first + priceBatch);
+        config.priceFunction->assignPrices(deltas, first, last, startingScore, prices);
+        for(int i = first; i < last; i++) {
+            const long double* scenarioPrice = &prices[(size_t)(i - first) * teams];
+            if(deltas.weights.empty()) {
+                for(int j = 0; j < teams; j++) {
+                    ev[j] += scenarioPrice[j] / (double) amount;
+                }
+            }
+            else {
+                for(int j = 0; j < teams; j++) {
+                    ev[j] += scenarioPrice[j] * deltas.weights[i];
+                }
+            }
+            if(runPrices != nullptr) {
+                runPrices[2 * i] += mass * scenarioPrice[homeTeam];
+                runPrices[2 * i + 1] += mass * scenarioPrice[awayTeam];
+            }
         }
-        delete scenarioPrice;
     }
-    return ev;
-}
\ No newline at end of file
+}
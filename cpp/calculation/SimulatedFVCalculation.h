@@ -2,15 +2,50 @@
 #define THESIS_SIMULATEDFVCALCULATION_H
 
 #include "./FVCalculation.h"
+#include "./ScenarioBlock.h"
+#include "./ScoreBlock.h"
+#include "./ScoreTable.h"
+#include "../OutcomeTable.h"
+#include "./RandomStream.h"
+#include "../samplers/Sampler.h"
+#include "./RunningStatistics.h"
+#include "./Arena.h"
+#include "../helpers/ThreadPool.h"
+#include "../helpers/TeamCount.h"
+#include <memory>
 
 class SimulatedFVCalculation: public FVCalculation {
 private:
-    int*** run(int _runs, map<vector<int>, tuple<float, float, float, int>> adaptations = {}, int start=0, int end = -1);
-    map<vector<int>, map<vector<int>, long double>> calculateTable(int*** scenarios, int amount) const;
-    long double* calculateEV(int*** scenarios, int amount, int start = 0, int end = -1, vector<int> staringScore = {}) const;
+    // Scratch memory of the game being calculated, reset at the start of every game
+    Arena arena;
+    // Simulated seasons of simulateDeltas, kept so their buffer is reused
+    ScenarioBlock seasons;
+    void run(ScenarioBlock& scenarios, int _runs, uint64_t stream, const OutcomePatches& patches = OutcomePatches(), int start=0, int end = -1, int first = 0);
+    ScenarioBlock runTilted(int _runs, uint64_t stream, long double tilt);
+    int leaderGap(const int* score) const;
+    uint64_t stream(int game, int strategy) const;
+    static OutcomePatches forcedOutcome(int homeTeam, int awayTeam, int strategy);
+    void simulateDeltas(int i, int j, int first, int count, ScoreBlock deltas[4]);
+    vector<ScoreTable> calculateTable(const ScenarioBlock& scenarios) const;
+    void calculateEV(const ScoreBlock& deltas, const int* startingScore, int homeTeam, int awayTeam, long double mass, double* runPrices, long double* prices, long double* ev) const;
+    template<int N>
+    void calculateEVFor(const ScoreBlock& deltas, const int* startingScore, int homeTeam, int awayTeam, long double mass, double* runPrices, long double* prices, long double* ev) const;
 public:
     Configuration config;
+    OutcomeTable outcomes;
     int runs = 1000;
+    // Worker threads used for simulation and EV evaluation, results do not depend on it
+    int threads = 1;
+    uint64_t seed = 0;
+    // Number of consecutive runs a worker simulates at once
+    static constexpr int runBlock = 64;
+    // Number of scenarios priced by one call of the price function
+    static constexpr int priceBatch = 256;
+    // Number of tasks the score states of a game are split into, fixed so results do not depend on the thread count
+    static constexpr int stateChunks = 64;
+    // Number of leading teams whose points importance sampling pulls together
+    static constexpr int contenders = 3;
+    shared_ptr<ThreadPool> pool;
     SimulatedFVCalculation(const Configuration& config);
     map<map<string,string>, list<vector<long double>>> calculate() override;
 };
@@ -168,10 +168,10 @@ map<vector<int>, tuple<float, float, float, int>> Data::readTeams(const string&
     return teams;
 }
 
-int* Data::readSelection(const string& fileName) {
+vector<int> Data::readSelection(const string& fileName) {
     vector<vector<string>> data = {};
     Data::readCSV(fileName, data);
-    int* selection = new int[data.size()];
+    vector<int> selection(data.size());
     for (int i = 0; i < data.size(); ++i) {
         selection[stoi(data[i][0])] = stoi(data[i][1]);
     }
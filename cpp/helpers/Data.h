@@ -17,7 +17,7 @@ public:
     static map<vector<int>, tuple<float, float, float, int>> generateTeams(int amount);
     static int writeTeams(const map<vector<int>, tuple<float, float, float, int>>& teams, const string& fileName);
     static map<vector<int>, tuple<float, float, float, int>> readTeams(const string& fileName);
-    static int* readSelection(const string& fileName);
+    static vector<int> readSelection(const string& fileName);
     static vector<int> readMapping(const string& fileName);
     static vector<double> readElo(const string& fileName);
     static map<int, string> readNaming(const string& fileName);
@@ -0,0 +1,41 @@
+#ifndef THESIS_TEAMCOUNT_H
+#define THESIS_TEAMCOUNT_H
+
+#include <array>
+#include <type_traits>
+#include <vector>
+
+using namespace std;
+
+// Number of teams of a kernel that is compiled for one league size.
+// N = 0 is the generic version, which takes the number of teams at runtime and keeps the scores on the heap
+template<int N>
+struct TeamCount {
+    static constexpr int value = N;
+    static constexpr bool fixed = N > 0;
+    using Scores = conditional_t<fixed, array<int, fixed ? N : 1>, vector<int>>;
+
+    static constexpr int size(int numberOfTeams) {
+        return fixed ? N : numberOfTeams;
+    }
+    static Scores scores(int numberOfTeams) {
+        if constexpr (fixed) return Scores{};
+        else return Scores(numberOfTeams);
+    }
+};
+
+// Call kernel with the TeamCount compiled for this league size, the league sizes we run most get their own version
+template<typename Kernel>
+decltype(auto) dispatchTeams(int numberOfTeams, Kernel&& kernel) {
+    switch(numberOfTeams) {
+        case 6: return kernel(TeamCount<6>());
+        case 10: return kernel(TeamCount<10>());
+        case 16: return kernel(TeamCount<16>());
+        case 18: return kernel(TeamCount<18>());
+        case 20: return kernel(TeamCount<20>());
+        default: return kernel(TeamCount<0>());
+    }
+}
+
+
+#endif //THESIS_TEAMCOUNT_H
@@ -0,0 +1,82 @@
+
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int threads) {
+    for(int i = 1; i < threads; i++) {
+        workers.emplace_back([this] { work(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        unique_lock<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for(auto& worker : workers) {
+        worker.join();
+    }
+}
+
+int ThreadPool::size() const {
+    return (int) workers.size() + 1;
+}
+
+void ThreadPool::parallelFor(int count, const function<void(int)>& body) {
+    if(workers.empty() || count <= 1) {
+        for(int i = 0; i < count; i++) {
+            body(i);
+        }
+        return;
+    }
+    {
+        unique_lock<mutex> guard(lock);
+        this->body = &body;
+        this->count = count;
+        this->next = 0;
+        this->error = nullptr;
+        generation++;
+    }
+    wake.notify_all();
+    drain(body, count);
+    unique_lock<mutex> guard(lock);
+    finished.wait(guard, [this] { return active == 0; });
+    this->body = nullptr;
+    if(error) {
+        rethrow_exception(error);
+    }
+}
+
+void ThreadPool::work() {
+    long seen = 0;
+    unique_lock<mutex> guard(lock);
+    while(true) {
+        wake.wait(guard, [&] { return stopping || generation != seen; });
+        if(stopping) return;
+        seen = generation;
+        if(body == nullptr) continue;
+        const function<void(int)>& job = *body;
+        int jobCount = count;
+        active++;
+        guard.unlock();
+        drain(job, jobCount);
+        guard.lock();
+        active--;
+        if(active == 0) {
+            finished.notify_all();
+        }
+    }
+}
+
+void ThreadPool::drain(const function<void(int)>& body, int count) {
+    int i;
+    while((i = next.fetch_add(1)) < count) {
+        try {
+            body(i);
+        } catch(...) {
+            unique_lock<mutex> guard(lock);
+            if(!error) error = current_exception();
+            next = count;
+        }
+    }
+}
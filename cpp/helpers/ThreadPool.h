@@ -0,0 +1,43 @@
+
+#ifndef THESIS_THREADPOOL_H
+#define THESIS_THREADPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <exception>
+
+using namespace std;
+
+// A fixed set of worker threads for data-parallel loops.
+// The calling thread takes part in every loop, so a pool of size 1 runs everything inline.
+class ThreadPool {
+public:
+    explicit ThreadPool(int threads);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    int size() const;
+    // Call body(i) for every i in [0, count) and wait until all calls returned
+    void parallelFor(int count, const function<void(int)>& body);
+private:
+    vector<thread> workers;
+    mutex lock;
+    condition_variable wake;
+    condition_variable finished;
+    const function<void(int)>* body = nullptr;
+    int count = 0;
+    atomic<int> next{0};
+    int active = 0;
+    long generation = 0;
+    bool stopping = false;
+    exception_ptr error;
+    void work();
+    void drain(const function<void(int)>& body, int count);
+};
+
+
+#endif //THESIS_THREADPOOL_H
@@ -0,0 +1,103 @@
+
+#include "WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool(int threads) {
+    if(threads < 1) threads = 1;
+    for(int i = 0; i < threads; i++) {
+        queues.push_back(make_unique<Queue>());
+    }
+    for(int i = 0; i < threads; i++) {
+        workers.emplace_back([this, i] { work(i); });
+    }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        unique_lock<mutex> guard(lock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for(auto& worker : workers) {
+        worker.join();
+    }
+}
+
+int WorkStealingPool::size() const {
+    return (int) workers.size();
+}
+
+void WorkStealingPool::submit(function<void()> task) {
+    size_t target;
+    {
+        unique_lock<mutex> guard(lock);
+        target = nextQueue++ % queues.size();
+        pending++;
+    }
+    {
+        unique_lock<mutex> guard(queues[target]->lock);
+        queues[target]->tasks.push_back(std::move(task));
+    }
+    {
+        unique_lock<mutex> guard(lock);
+        queued++;
+    }
+    wake.notify_one();
+}
+
+void WorkStealingPool::wait() {
+    unique_lock<mutex> guard(lock);
+    idle.wait(guard, [this] { return pending == 0; });
+    if(error) {
+        exception_ptr thrown = error;
+        error = nullptr;
+        rethrow_exception(thrown);
+    }
+}
+
+bool WorkStealingPool::take(int self, function<void()>& task) {
+    {
+        unique_lock<mutex> guard(queues[self]->lock);
+        if(!queues[self]->tasks.empty()) {
+            task = std::move(queues[self]->tasks.back());
+            queues[self]->tasks.pop_back();
+            return true;
+        }
+    }
+    for(size_t k = 1; k < queues.size(); k++) {
+        Queue& victim = *queues[(self + k) % queues.size()];
+        unique_lock<mutex> guard(victim.lock);
+        if(!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void WorkStealingPool::work(int self) {
+    while(true) {
+        {
+            unique_lock<mutex> guard(lock);
+            wake.wait(guard, [this] { return stopping || queued > 0; });
+            if(stopping && queued == 0) return;
+        }
+        function<void()> task;
+        if(!take(self, task)) continue;
+        {
+            unique_lock<mutex> guard(lock);
+            queued--;
+        }
+        try {
+            task();
+        } catch(...) {
+            unique_lock<mutex> guard(lock);
+            if(!error) error = current_exception();
+        }
+        unique_lock<mutex> guard(lock);
+        pending--;
+        if(pending == 0) {
+            idle.notify_all();
+        }
+    }
+}
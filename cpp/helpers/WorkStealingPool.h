@@ -0,0 +1,49 @@
+
+#ifndef THESIS_WORKSTEALINGPOOL_H
+#define THESIS_WORKSTEALINGPOOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <exception>
+
+using namespace std;
+
+// A pool for independent, coarse tasks of uneven length.
+// Every worker owns a queue, works through it from the back and steals from
+// the front of the other queues once its own runs dry.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threads);
+    ~WorkStealingPool();
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+    int size() const;
+    void submit(function<void()> task);
+    // Block until every submitted task finished, rethrows the first exception a task threw
+    void wait();
+private:
+    struct Queue {
+        mutex lock;
+        deque<function<void()>> tasks;
+    };
+    vector<unique_ptr<Queue>> queues;
+    vector<thread> workers;
+    mutex lock;
+    condition_variable wake;
+    condition_variable idle;
+    int queued = 0;
+    int pending = 0;
+    size_t nextQueue = 0;
+    bool stopping = false;
+    exception_ptr error;
+    bool take(int self, function<void()>& task);
+    void work(int self);
+};
+
+
+#endif //THESIS_WORKSTEALINGPOOL_H
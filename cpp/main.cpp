@@ -1,4 +1,5 @@
 #include <iostream>
+#include <cmath>
 #include <random>
 #include <set>
 #include <sstream>
@@ -7,7 +8,11 @@
 #include <nlohmann/json.hpp>
 #include "./helpers/JSON.h"
 #include "./calculation/SimulatedFVCalculation.h"
+#include "./calculation/ExactFVCalculation.h"
+#include "./optimization/RoundSwitchingOptimization.h"
 #include "./helpers/Data.h"
+#include "./helpers/WorkStealingPool.h"
+#include <mutex>
 
 using namespace std;
 using json = nlohmann::json;
@@ -102,7 +107,12 @@ map<string,map<string,string>> processResults(vector<tuple<Configuration, map<ma
                                           "Eg_max(p)",
                                           "Eg(p|e0)",
                                           "Eg(p|e1)",
-                                          "Eg(p|e2)"}};
+                                          "Eg(p|e2)",
+                                          "SE(p|e0)",
+                                          "SE(p|e1)",
+                                          "SE(p|e2)",
+                                          "runs",
+                                          "discardedMass"}};
     map<string,map<string,string>> termTranslation = {};
     for (const auto& outer_tuple : rrr) {
         const Configuration& config = std::get<0>(outer_tuple);
@@ -114,9 +124,9 @@ map<string,map<string,string>> processResults(vector<tuple<Configuration, map<ma
                 
                 // Check if elo is set otherwise set to NA
                 string homeEloStr, awayEloStr, eloDifferenceStr;
-                if (!config.elo.empty() && stoi(key_map.at("homeTeam")) < config.elo.size() && stoi(key_map.at("awayTeam")) < config.elo.size()) {
-                    double homeElo = config.elo[stoi(key_map.at("homeTeam"))];
-                    double awayElo = config.elo[stoi(key_map.at("awayTeam"))];
+                if (!config.core->elo.empty() && stoi(key_map.at("homeTeam")) < config.core->elo.size() && stoi(key_map.at("awayTeam")) < config.core->elo.size()) {
+                    double homeElo = config.core->elo[stoi(key_map.at("homeTeam"))];
+                    double awayElo = config.core->elo[stoi(key_map.at("awayTeam"))];
                     double eloDifference = abs(homeElo - awayElo);
                     homeEloStr = to_string(homeElo);
                     awayEloStr = to_string(awayElo);
@@ -152,9 +162,18 @@ map<string,map<string,string>> processResults(vector<tuple<Configuration, map<ma
                 if(config.pre.at("exactHighestFirst")) {
                     pre += "exactHighestFirst";
                 }
+                if(config.pre.at("annealingHighestLast")) {
+                    pre += "annealingHighestLast";
+                }
+                if(config.pre.at("annealingHighestFirst")) {
+                    pre += "annealingHighestFirst";
+                }
                 if(config.pre.at("random")) {
                     pre += "random";
                 }
+                if(config.pre.at("roundSwitching")) {
+                    pre += (pre.empty() ? "" : "+") + string("roundSwitching");
+                }
                 lineBase.push_back(pre);
                 // Generate the mapping string
                 {
@@ -179,53 +198,25 @@ map<string,map<string,string>> processResults(vector<tuple<Configuration, map<ma
                             string s2 = addKeyWithNextLetter("", &termTranslation["selection (TM)"], mappingKey);
                             lineBase.push_back(s2);
                         }
-                        if(config.pre.at("exactHighestLast")) {
-                            if (termTranslation.find("pre (PR)") == termTranslation.end()) {
-                                termTranslation["pre (PR)"] = {};
-                            }
-                            if(termTranslation["pre (PR)"].find("exactHighestLast") != termTranslation["pre (PR)"].end()) {
-                                lineBase.push_back(termTranslation["pre (PR)"].find("exactHighestLast")->second);
-                            }
-                            else {
-                                string s2 = addKeyWithNextLetter("", &termTranslation["pre (PR)"], "exactHighestLast");
-                                lineBase.push_back(s2);
+                        string preKey = "none";
+                        for(const char* optimization : {"exactHighestLast", "exactHighestFirst", "annealingHighestLast", "annealingHighestFirst", "random"}) {
+                            if(config.pre.at(optimization)) {
+                                preKey = optimization;
+                                break;
                             }
                         }
-                        else if(config.pre.at("exactHighestFirst")) {
-                            if (termTranslation.find("pre (PR)") == termTranslation.end()) {
-                                termTranslation["pre (PR)"] = {};
-                            }
-                            if(termTranslation["pre (PR)"].find("exactHighestFirst") != termTranslation["pre (PR)"].end()) {
-                                lineBase.push_back(termTranslation["pre (PR)"].find("exactHighestFirst")->second);
-                            }
-                            else {
-                                string s2 = addKeyWithNextLetter("", &termTranslation["pre (PR)"], "exactHighestFirst");
-                                lineBase.push_back(s2);
-                            }
+                        if(config.pre.at("roundSwitching")) {
+                            preKey += "+roundSwitching";
                         }
-                        else if(config.pre.at("random")) {
-                            if (termTranslation.find("pre (PR)") == termTranslation.end()) {
-                                termTranslation["pre (PR)"] = {};
-                            }
-                            if(termTranslation["pre (PR)"].find("random") != termTranslation["pre (PR)"].end()) {
-                                lineBase.push_back(termTranslation["pre (PR)"].find("random")->second);
-                            }
-                            else {
-                                string s2 = addKeyWithNextLetter("", &termTranslation["pre (PR)"], "random");
-                                lineBase.push_back(s2);
-                            }
+                        if (termTranslation.find("pre (PR)") == termTranslation.end()) {
+                            termTranslation["pre (PR)"] = {};
+                        }
+                        if(termTranslation["pre (PR)"].find(preKey) != termTranslation["pre (PR)"].end()) {
+                            lineBase.push_back(termTranslation["pre (PR)"].find(preKey)->second);
                         }
                         else {
-                            if (termTranslation.find("pre (PR)") == termTranslation.end()) {
-                                termTranslation["pre (PR)"] = {};
-                            }
-                            if(termTranslation["pre (PR)"].find("none") != termTranslation["pre (PR)"].end()) {
-                                lineBase.push_back(termTranslation["pre (PR)"].find("none")->second);
-                            }
-                            else {
-                                string s2 = addKeyWithNextLetter("", &termTranslation["pre (PR)"], "none");
-                                lineBase.push_back(s2);
-                            }
+                            string s2 = addKeyWithNextLetter("", &termTranslation["pre (PR)"], preKey);
+                            lineBase.push_back(s2);
                         }
                         // Generate the price function string
                         if (termTranslation.find("priceFunction (PC)") == termTranslation.end()) {
@@ -271,6 +262,13 @@ map<string,map<string,string>> processResults(vector<tuple<Configuration, map<ma
                 line.push_back(to_string(vec[1]));
                 line.push_back(to_string(vec[2]));
                 line.push_back(to_string(vec[3]));
+                // Standard errors of the three fraud values and the number of post-runs used
+                for(size_t k = 4; k < 7; k++) {
+                    line.push_back(k < vec.size() && !isnan(vec[k]) ? to_string(vec[k]) : "NA");
+                }
+                line.push_back(vec.size() > 7 ? to_string((long) vec[7]) : "NA");
+                // Probability mass of the score states left out of this round
+                line.push_back(vec.size() > 8 ? to_string(vec[8]) : "NA");
                 out.push_back(line);
             }
         }
@@ -291,7 +289,7 @@ vector<string> splitString(const string& str, char delim) {
 }
 
 
-int runMain(const std::string& configPath, const std::string& outputPath, bool benchmarkMode = false) {
+int runMain(const std::string& configPath, const std::string& outputPath, bool benchmarkMode = false, int threads = 0, int jobs = 1) {
         // Read configurations from the provided config file
         std::ifstream f(configPath);
         if (!f.is_open()) {
@@ -378,6 +376,25 @@ int runMain(const std::string& configPath, const std::string& outputPath, bool b
             vector<string> preRuns_str = {to_string(preRuns)};
             vector<string> postRuns_str = {to_string(postRuns)};
 
+            // Settings passed unchanged to every generated configuration
+            map<string, string> settings;
+            settings["threads"] = to_string(config_json.value("threads", 1));
+            settings["estimator"] = config_json.value("estimator", "independent");
+            settings["sampler"] = config_json.value("sampler", "philox");
+            settings["importance"] = to_string(config_json.value("importance", 0.0));
+            settings["distMass"] = to_string(config_json.value("distMass", 1.0));
+            settings["distMerge"] = config_json.value("distMerge", false) ? "true" : "false";
+            settings["targetError"] = to_string(config_json.value("targetError", 0.0));
+            settings["maxRuns"] = to_string(config_json.value("maxRuns", -1));
+            settings["tailEnumeration"] = to_string(config_json.value("tailEnumeration", 0L));
+            settings["engine"] = config_json.value("engine", "simulated");
+            settings["stateBudget"] = to_string(config_json.value("stateBudget", 1000000L));
+            settings["annealingSteps"] = to_string(config_json.value("annealingSteps", 1000000L));
+            settings["annealingRestarts"] = to_string(config_json.value("annealingRestarts", 8));
+            settings["annealingTime"] = to_string(config_json.value("annealingTime", 0.0));
+            settings["roundSwitching"] = config_json.value("roundSwitching", "none");
+            settings["roundSwitchingCandidates"] = to_string(config_json.value("roundSwitchingCandidates", 4));
+
             vector<Configuration> generated_configs = Configuration::generateConfigurations(
                 &rng,
                 schedule,
@@ -390,6 +407,7 @@ int runMain(const std::string& configPath, const std::string& outputPath, bool b
                 runs_str,
                 preRuns_str,
                 postRuns_str,
+                settings,
                 path
             );
             all_configs.insert(all_configs.end(), generated_configs.begin(), generated_configs.end());
@@ -405,31 +423,69 @@ int runMain(const std::string& configPath, const std::string& outputPath, bool b
         auto program_start = std::chrono::high_resolution_clock::now();
 
         std::vector<TupleType> myTupleVector;
+
+        // Configurations are independent, run them concurrently and collect the results by index
+        // so the output keeps the order of all_configs
+        vector<map<map<string,string>, list<vector<long double>>>> configResults(all_configs.size());
+        iteration_times.assign(all_configs.size(), 0.0);
+        mutex outputLock;
         int count = 0;
-        for (const Configuration& currentConfig : all_configs) {
-            auto start = std::chrono::high_resolution_clock::now();
-            cout << count << "/" << all_configs.size() << endl;
-            count++;
-            vector<string> line = {};
-            Configuration thisConfig = Configuration(currentConfig);
-            SimulatedFVCalculation calc = SimulatedFVCalculation(thisConfig);
+        WorkStealingPool sweep(jobs);
+        for (size_t c = 0; c < all_configs.size(); c++) {
+            sweep.submit([&, c] {
+                auto start = std::chrono::high_resolution_clock::now();
+                {
+                    lock_guard<mutex> guard(outputLock);
+                    cout << c << "/" << all_configs.size() << endl;
+                }
+                Configuration thisConfig = Configuration(all_configs[c]);
+                // Every candidate order is a full calculation, so the round order is optimized here,
+                // concurrently with the other configurations. The output reads the optimized schedule
+                if (thisConfig.roundSwitchingOptimization) {
+                    thisConfig.threads = threads > 0 ? threads : thisConfig.threads;
+                    RoundSwitchingOptimization opt = RoundSwitchingOptimization();
+                    thisConfig = opt.optimize(thisConfig);
+                    all_configs[c] = thisConfig;
+                }
+                bool simulate = thisConfig.engine == "simulated";
+                if (!simulate) {
+                    ExactFVCalculation exact = ExactFVCalculation(thisConfig);
+                    exact.threads = threads > 0 ? threads : thisConfig.threads;
+                    try {
+                        configResults[c] = exact.calculate();
+                    } catch (const StateBudgetExceeded& e) {
+                        lock_guard<mutex> guard(outputLock);
+                        cerr << "Warning: " << e.what() << ", falling back to simulation for configuration " << c << endl;
+                        simulate = true;
+                    }
+                }
+                if (simulate) {
+                    SimulatedFVCalculation calc = SimulatedFVCalculation(thisConfig);
 
-            // Set runs from config
-            calc.runs = thisConfig.runs;
+                    // Set runs from config
+                    calc.runs = thisConfig.runs;
+                    calc.threads = threads > 0 ? threads : thisConfig.threads;
+                    calc.seed = seed_val;
 
-            map<map<string,string>, list<vector<long double>>> r = calc.calculate();
+                    configResults[c] = calc.calculate();
+                }
 
-            // Iterate over the map
-            auto end = std::chrono::high_resolution_clock::now();
-            std::chrono::duration<double, std::nano> iteration_duration = end - start;
-            double duration_in_minutes = iteration_duration.count() / (60.0 * 1e9);
+                auto end = std::chrono::high_resolution_clock::now();
+                std::chrono::duration<double, std::nano> iteration_duration = end - start;
+                double duration_in_minutes = iteration_duration.count() / (60.0 * 1e9);
 
-            iteration_times.push_back(duration_in_minutes);
-            std::cout << "Iteration " << count << " time: " << duration_in_minutes << " minutes" << std::endl;
+                iteration_times[c] = duration_in_minutes;
+                lock_guard<mutex> guard(outputLock);
+                count++;
+                std::cout << "Iteration " << c + 1 << " time: " << duration_in_minutes << " minutes (" << count << "/" << all_configs.size() << " done)" << std::endl;
+            });
+        }
+        sweep.wait();
 
-            rrr.emplace_back(thisConfig, r);
+        for (size_t c = 0; c < all_configs.size(); c++) {
+            rrr.emplace_back(all_configs[c], configResults[c]);
         }
-        
+
         // End total program timer
         auto program_end = std::chrono::high_resolution_clock::now();
         std::chrono::duration<double, std::nano> total_duration = program_end - program_start;
@@ -473,51 +529,14 @@ int runMain(const std::string& configPath, const std::string& outputPath, bool b
 }
 
 
-int*** run(Configuration config, int _runs, map<vector<int>, tuple<float, float, float, int>> adaptations, int start, int end) {
-    int _end = end;
-    if(_end < 0) _end = config.rounds;
-    uniform_real_distribution<float> uniform(0, 1);
-    int*** scenario = new int**[_runs];
-    for(int i = 0; i < _runs; i++) {
-        scenario[i] = new int*[_end - start];
-        for(int j = start; j < _end; j++) {
-            scenario[i][j - start] = new int[config.numberOfTeams / 2];
-            for(int k = 0; k < config.numberOfTeams / 2; k++) {
-                float randomNumber = uniform(*config.rng);
-                int homeTeam = config.schedule[j][2*k];
-                int awayTeam = config.schedule[j][2*k+1];
-                vector<int> index = {homeTeam, awayTeam};
-                float homeWinOdds = get<0>(config.teams[index]);
-                float awayWinnOdds = get<1>(config.teams[index]);
-                scenario[i][j - start][k] = config.predictor->predict(randomNumber, index, adaptations);
-            }
-        }
-    }
-    return scenario;
-}
-
-long double* calculateEV(Configuration config, int*** scenarios, int amount, int start, int end, vector<int> staringScore) {
-    int _end = end;
-    if(_end < 0) _end = config.rounds;
-    vector<int> zeros(config.numberOfTeams, 0);
-    if(staringScore.empty()) staringScore = zeros;
-    auto* ev = new long double[config.numberOfTeams];
-    for(int i = 0; i < amount; i++) {
-        long double* scenarioPrice = config.priceFunction->assignPrice(scenarios[i], start, _end, staringScore);
-        for(int j = 0; j < config.numberOfTeams; j++) {
-            ev[j] += scenarioPrice[j] / (double) amount;
-        }
-        delete scenarioPrice;
-    }
-    return ev;
-}
-
 //./thesis -c ./in.json -o ./out.csv
 int main(int argc, char* argv[]) {
     // Set default values for configPath and outputPath
     std::string configPath = "./in_default.json";
     std::string outputPath = "./out_default.csv"; // Default output path
     bool benchmarkMode = false;
+    int threads = 0; // Simulation threads per configuration, 0 uses the "threads" value of the config file
+    int jobs = 1; // Configurations calculated concurrently
     
     // Parse command line arguments
     for (int i = 1; i < argc; i++) {
@@ -530,6 +549,12 @@ int main(int argc, char* argv[]) {
             i++; // Skip the next argument since we've used it
         } else if (arg == "-b") {
             benchmarkMode = true;
+        } else if (arg == "-t" && i + 1 < argc) {
+            threads = stoi(argv[i + 1]);
+            i++; // Skip the next argument since we've used it
+        } else if ((arg == "--jobs" || arg == "-j") && i + 1 < argc) {
+            jobs = stoi(argv[i + 1]);
+            i++; // Skip the next argument since we've used it
         }
     }
     
@@ -537,8 +562,10 @@ int main(int argc, char* argv[]) {
         std::cerr << "Error: No config file specified. Please use -c flag to specify the config file path." << std::endl;
         std::cerr << "Example: " << argv[0] << " -c ./in.json -o ./lineout.csv" << std::endl;
         std::cerr << "Use -b flag to enable benchmark mode (outputs timing CSV)" << std::endl;
+        std::cerr << "Use -t <threads> to set the number of simulation threads" << std::endl;
+        std::cerr << "Use --jobs <n> to calculate n configurations concurrently" << std::endl;
         return 1;
     }
     
-    return runMain(configPath, outputPath, benchmarkMode);
+    return runMain(configPath, outputPath, benchmarkMode, threads, jobs);
 }
@@ -0,0 +1,172 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include "AnnealingMappingOptimization.h"
+#include "MappingSearch.h"
+#include "../helpers/ThreadPool.h"
+
+AnnealingMappingOptimization::AnnealingMappingOptimization(bool highestLast) : Optimization() {
+    this->highestLast = highestLast;
+}
+
+AnnealingMappingOptimization::AnnealingMappingOptimization(AnnealingMappingOptimization& other) : Optimization(other) {
+    this->highestLast = other.highestLast;
+}
+
+Configuration AnnealingMappingOptimization::optimize(Configuration config) {
+    if (config.core->elo.size() != (size_t) config.numberOfTeams) {
+        throw runtime_error("Error: the annealing mapping optimization ranks the teams by elo, but no elo ratings are given");
+    }
+    vector<int> ranking(config.numberOfTeams);
+    for (int i = 0; i < config.numberOfTeams; i++) ranking[i] = i;
+    sort(ranking.begin(), ranking.end(), [&](int a, int b) {
+        return config.core->elo[a] > config.core->elo[b];
+    });
+
+    vector<long> roundWeight = MappingSearch::roundWeights(config.rounds, highestLast);
+    vector<long> pairWeight = MappingSearch::pairWeights(config.schedule, config.rounds, config.numberOfTeams, roundWeight);
+
+    uint64_t seed = 0;
+    if (config.rng != nullptr) {
+        seed = (*config.rng)();
+    }
+    // The first restart starts from the current mapping, the others from random ones
+    vector<Restart> restarts(max(1, config.annealingRestarts));
+    int workers = max(1, min(config.threads, (int) restarts.size()));
+    ThreadPool pool(workers);
+    // The time budget is shared: restarts run in waves of workers, so each gets the budget divided by the number of waves
+    double budget = config.annealingTime * workers / (double) restarts.size();
+    auto deadline = chrono::steady_clock::now() + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(config.annealingTime));
+    pool.parallelFor((int) restarts.size(), [&](int r) {
+        restarts[r] = anneal(ranking, pairWeight, config.numberOfTeams, config.annealingSteps, budget, deadline, seed + r, r == 0);
+    });
+    const Restart* best = &restarts[0];
+    for (const Restart& restart : restarts) {
+        if (restart.cost < best->cost) best = &restart;
+    }
+    const vector<int>& bestPermutation = best->permutation;
+
+    Configuration optimizedConfig(config);
+    optimizedConfig.ownSchedule();
+    for(int i = 0; i < config.rounds; i++) {
+        for(int j = 0; j < config.numberOfTeams; j++) {
+            optimizedConfig.schedule[i][j] = bestPermutation[config.schedule[i][j]];
+        }
+    }
+    for(int i = 0; i < config.numberOfTeams; i++) {
+        optimizedConfig.mapping[i] = bestPermutation[optimizedConfig.mapping[i]];
+    }
+    return optimizedConfig;
+}
+
+// Anneal over the positions ranking[p[t]] of the teams. Swapping the positions of two teams only changes
+// their own matches, so a step costs O(N). The temperature falls geometrically from the typical cost change
+// of a swap to a thousandth of it over the steps, or over the time budget in seconds if that is shorter
+AnnealingMappingOptimization::Restart AnnealingMappingOptimization::anneal(const vector<int>& ranking, const vector<long>& pairWeight, int numberOfTeams, long steps, double budget, chrono::steady_clock::time_point deadline, uint64_t seed, bool identity) const {
+    int n = numberOfTeams;
+    mt19937_64 gen(seed);
+    vector<int> permutation(n);
+    for (int i = 0; i < n; i++) permutation[i] = i;
+    if (!identity) {
+        shuffle(permutation.begin(), permutation.end(), gen);
+    }
+    vector<int> position(n);
+    for (int t = 0; t < n; t++) position[t] = ranking[permutation[t]];
+
+    long cost = 0;
+    for (int a = 0; a < n; a++) {
+        for (int b = a + 1; b < n; b++) {
+            cost += pairWeight[a * n + b] * abs(position[a] - position[b]);
+        }
+    }
+    Restart best;
+    best.permutation = permutation;
+    best.cost = cost;
+    if (n < 3) {
+        return best;
+    }
+
+    auto delta = [&](int a, int b) {
+        long change = 0;
+        const long* rowA = &pairWeight[(size_t) a * n];
+        const long* rowB = &pairWeight[(size_t) b * n];
+        for (int c = 0; c < n; c++) {
+            if (c == a || c == b) continue;
+            long towardA = abs(position[a] - position[c]);
+            long towardB = abs(position[b] - position[c]);
+            change += (rowA[c] - rowB[c]) * (towardB - towardA);
+        }
+        return change;
+    };
+    uniform_int_distribution<int> team(0, n - 1);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+    auto pick = [&](int& a, int& b) {
+        a = team(gen);
+        do b = team(gen); while (b == a);
+    };
+
+    double typical = 0.0;
+    int samples = 100;
+    for (int s = 0; s < samples; s++) {
+        int a, b;
+        pick(a, b);
+        typical += fabs((double) delta(a, b)) / samples;
+    }
+    double initial = max(typical, 1.0);
+    double temperature = initial;
+
+    auto start = chrono::steady_clock::now();
+    bool budgeted = budget > 0.0;
+    if (budgeted) {
+        // A restart that starts late only gets the time left until the deadline
+        budget = min(budget, chrono::duration<double>(deadline - start).count());
+    }
+    for (long step = 0; step < steps; step++) {
+        // The temperature is updated every few hundred steps from the share of the steps or the time budget used
+        if (step % 256 == 0) {
+            double progress = (double) step / (double) steps;
+            if (budgeted) {
+                double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+                if (elapsed >= budget) break;
+                progress = max(progress, elapsed / budget);
+            }
+            temperature = initial * pow(1e-3, progress);
+        }
+        int a, b;
+        pick(a, b);
+        long change = delta(a, b);
+        if (change <= 0 || uniform(gen) < exp(-(double) change / temperature)) {
+            swap(position[a], position[b]);
+            swap(permutation[a], permutation[b]);
+            cost += change;
+            if (cost < best.cost) {
+                best.cost = cost;
+                best.permutation = permutation;
+            }
+        }
+    }
+
+    // Finish with swaps that still help
+    for (int t = 0; t < n; t++) position[t] = ranking[best.permutation[t]];
+    permutation = best.permutation;
+    cost = best.cost;
+    for (bool improved = true; improved; ) {
+        improved = false;
+        for (int a = 0; a < n; a++) {
+            for (int b = a + 1; b < n; b++) {
+                long change = delta(a, b);
+                if (change < 0) {
+                    swap(position[a], position[b]);
+                    swap(permutation[a], permutation[b]);
+                    cost += change;
+                    improved = true;
+                }
+            }
+        }
+    }
+    best.permutation = permutation;
+    best.cost = cost;
+    return best;
+}
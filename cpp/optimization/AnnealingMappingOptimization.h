@@ -0,0 +1,28 @@
+#ifndef THESIS_ANNEALINGMAPPINGOPTIMIZATION_H
+#define THESIS_ANNEALINGMAPPINGOPTIMIZATION_H
+
+#include "./Optimization.h"
+#include <chrono>
+#include <cstdint>
+
+// The objective of the exact mapping optimizations minimized by simulated annealing over swaps of two teams,
+// for leagues too large to search exactly. Every restart anneals from its own starting permutation on one of
+// config.threads workers, and the best permutation of all restarts is kept. config.annealingTime bounds the whole
+// optimization: every restart gets its share of the workers' time and all of them stop at a common deadline
+class AnnealingMappingOptimization: public Optimization {
+private:
+    bool highestLast;
+    struct Restart {
+        vector<int> permutation;
+        long cost = 0;
+    };
+    Restart anneal(const vector<int>& ranking, const vector<long>& pairWeight, int numberOfTeams, long steps, double budget, chrono::steady_clock::time_point deadline, uint64_t seed, bool identity) const;
+public:
+    // Weigh the matches of the last instead of the first half of the season, as ExactHighestLastMappingOptimization
+    AnnealingMappingOptimization(bool highestLast);
+    AnnealingMappingOptimization(AnnealingMappingOptimization& other);
+    Configuration optimize(Configuration config);
+};
+
+
+#endif //THESIS_ANNEALINGMAPPINGOPTIMIZATION_H
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <cmath>
 #include "ExactHigestFirstMappingOptimization.h"
+#include "MappingSearch.h"
 
 ExactHigestFirstMappingOptimization::ExactHigestFirstMappingOptimization() : Optimization() {
 }
@@ -13,52 +14,20 @@ Configuration ExactHigestFirstMappingOptimization::optimize(Configuration config
     vector<int> ranking(config.numberOfTeams);
     for (int i = 0; i < config.numberOfTeams; i++) ranking[i] = i;
     sort(ranking.begin(), ranking.end(), [&](int a, int b) {
-        return config.elo[a] > config.elo[b];
+        return config.core->elo[a] > config.core->elo[b];
     });
 
 
-    vector<int> perm(config.numberOfTeams);
-    for (int i = 0; i < config.numberOfTeams; i++) perm[i] = i;
-    vector<vector<int>> all_permutations;
-    do {
-        all_permutations.push_back(perm);
-    } while (next_permutation(perm.begin(), perm.end()));
+    vector<long> roundWeight = MappingSearch::roundWeights(config.rounds, false);
+    MappingSearch search(ranking, config.schedule, config.rounds, roundWeight);
+    search.threads = config.threads;
+    vector<int> bestPermutation = search.best();
 
-    vector<int> bestPermutation = all_permutations[0];
-    double bestAverageRankDifference = numeric_limits<double>::max();
-
-    vector<double> roundWeight(config.rounds, 0.0);
-
-    int half = (config.rounds + 1) / 2;
-
-    for (int i = 0; i < half; i++) {
-        roundWeight[i] = half - i;
-    }
-
-    double sum = accumulate(roundWeight.begin(), roundWeight.end(), 0.0);
-    if (sum > 0) {
-        for (int i = 0; i < half; i++) {
-            roundWeight[i] /= sum;
-        }
-    }
-
-    for (const auto& p : all_permutations) {
-        double averageRankDifference = 0;
-
-        for(int i = 0; i < config.rounds; i++) {
-            for(int j = 0; j < config.numberOfTeams / 2; j++) {
-                averageRankDifference += roundWeight[i] * (double)abs(ranking[p[config.schedule[i][2*j]]] - ranking[p[config.schedule[i][2*j + 1]]]) / (double)(config.numberOfTeams * config.rounds);
-            }
-        }
-        if(averageRankDifference < bestAverageRankDifference) {
-            bestPermutation = p;
-            bestAverageRankDifference = averageRankDifference;
-        }
-    }
     Configuration optimizedConfig(config);
+    optimizedConfig.ownSchedule();
     for(int i = 0; i < config.rounds; i++) {
         for(int j = 0; j < config.numberOfTeams; j++) {
-            config.schedule[i][j] = bestPermutation[config.schedule[i][j]];
+            optimizedConfig.schedule[i][j] = bestPermutation[config.schedule[i][j]];
         }
     }
     for(int i = 0; i < config.numberOfTeams; i++) {
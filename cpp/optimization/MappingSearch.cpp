@@ -0,0 +1,281 @@
+#include "MappingSearch.h"
+#include "../helpers/ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+
+MappingSearch::MappingSearch(const vector<int>& ranking, int** schedule, int rounds, const vector<long>& roundWeight) {
+    this->ranking = ranking;
+    numberOfTeams = (int) ranking.size();
+    int n = numberOfTeams;
+    rankOf.assign(n, 0);
+    for(int k = 0; k < n; k++) {
+        rankOf[ranking[k]] = k;
+    }
+    pairWeight = pairWeights(schedule, rounds, n, roundWeight);
+    neighbourWeights.assign(n + 1, vector<vector<long>>(n));
+    for(int t = 0; t < n; t++) {
+        for(int u = t; u < n; u++) {
+            for(int w = t; w < n; w++) {
+                if(w != u) neighbourWeights[t][u].push_back(pairWeight[u * n + w]);
+            }
+            sort(neighbourWeights[t][u].rbegin(), neighbourWeights[t][u].rend());
+        }
+    }
+}
+
+vector<long> MappingSearch::roundWeights(int rounds, bool highestLast) {
+    vector<long> roundWeight(rounds, 0);
+    int half = (rounds + 1) / 2;
+    for(int i = 0; i < half; i++) {
+        roundWeight[i] = half - i;
+    }
+    if(highestLast) {
+        reverse(roundWeight.begin(), roundWeight.end());
+    }
+    return roundWeight;
+}
+
+vector<long> MappingSearch::pairWeights(int** schedule, int rounds, int numberOfTeams, const vector<long>& roundWeight) {
+    int n = numberOfTeams;
+    vector<long> pairWeight((size_t) n * n, 0);
+    for(int i = 0; i < rounds; i++) {
+        for(int j = 0; j < n / 2; j++) {
+            int homeTeam = schedule[i][2*j];
+            int awayTeam = schedule[i][2*j+1];
+            pairWeight[homeTeam * n + awayTeam] += roundWeight[i];
+            pairWeight[awayTeam * n + homeTeam] += roundWeight[i];
+        }
+    }
+    return pairWeight;
+}
+
+long MappingSearch::cost(const vector<int>& permutation) const {
+    int n = numberOfTeams;
+    long total = 0;
+    for(int a = 0; a < n; a++) {
+        for(int b = a + 1; b < n; b++) {
+            total += pairWeight[a * n + b] * abs(ranking[permutation[a]] - ranking[permutation[b]]);
+        }
+    }
+    return total;
+}
+
+vector<int> MappingSearch::best() const {
+    int n = numberOfTeams;
+    vector<int> identity(n);
+    for(int i = 0; i < n; i++) identity[i] = i;
+    if(n < 3) {
+        return identity;
+    }
+    // The identity is the first permutation, so it is only replaced by a strictly better one.
+    // Swapping pairs of teams while that helps gives a good permutation to bound the search with
+    long identityCost = cost(identity);
+    vector<int> swapped = identity;
+    long swappedCost = identityCost;
+    for(bool improved = true; improved; ) {
+        improved = false;
+        for(int a = 0; a < n; a++) {
+            for(int b = a + 1; b < n; b++) {
+                swap(swapped[a], swapped[b]);
+                long c = cost(swapped);
+                if(c < swappedCost) {
+                    swappedCost = c;
+                    improved = true;
+                }
+                else {
+                    swap(swapped[a], swapped[b]);
+                }
+            }
+        }
+    }
+    atomic<long> shared(swappedCost);
+    // One task per choice of p[0] and p[1], in lexicographic order
+    vector<Branch> results(n * n);
+    ThreadPool pool(max(1, threads));
+    pool.parallelFor(n * n, [&](int task) {
+        int first = task / n;
+        int second = task % n;
+        if(first == second) return;
+        // Skip p[0] whose mirror is an earlier p[0], the mirrored permutations there cost the same
+        if(rankOf[n - 1 - ranking[first]] < first) return;
+        search(first, second, shared, results[task]);
+    });
+    vector<int> bestPermutation = identity;
+    long bestCost = identityCost;
+    for(const Branch& branch : results) {
+        if(branch.cost >= 0 && branch.cost < bestCost) {
+            bestCost = branch.cost;
+            bestPermutation = branch.permutation;
+        }
+    }
+    return bestPermutation;
+}
+
+// State of the depth-first search of one branch
+struct MappingSearch::Walk {
+    const MappingSearch& search;
+    int n;
+    atomic<long>& shared;
+    Branch& result;
+    vector<int> permutation;
+    vector<char> used;
+    // partial[u * n + x]: cost of the matches of team u with the assigned teams if u ends up at position x
+    vector<long> partial;
+    // Free positions in increasing order
+    vector<int> free;
+    // Distances from every free position to the others, nearest first
+    vector<int> distances;
+    // Bounding costs of the later teams at the free positions, and the state of the Hungarian method
+    vector<long> assignment;
+    vector<long> potentials[2];
+    vector<long> slack;
+    vector<int> match;
+    vector<int> way;
+    vector<char> visited;
+
+    Walk(const MappingSearch& search, atomic<long>& shared, Branch& result) :
+            search(search), n(search.numberOfTeams), shared(shared), result(result),
+            permutation(n, -1), used(n, 0), partial((size_t) n * n, 0), free(n), distances((size_t) n * n, 0),
+            assignment((size_t) n * n, 0), slack(n + 1), match(n + 1), way(n + 1), visited(n + 1) {
+        potentials[0].assign(n + 1, 0);
+        potentials[1].assign(n + 1, 0);
+    }
+
+    void assign(int t, int value, long sign) {
+        int x = search.ranking[value];
+        permutation[t] = value;
+        used[value] = sign > 0;
+        for(int u = t + 1; u < n; u++) {
+            long w = search.pairWeight[t * n + u];
+            if(w == 0) continue;
+            long* row = &partial[(size_t) u * n];
+            for(int y = 0; y < n; y++) {
+                row[y] += sign * w * abs(y - x);
+            }
+        }
+    }
+
+    // Lower bound of the cost of the matches that involve a team after t, the Gilmore-Lawler bound: placing team u
+    // at the free position x costs at least its matches with the assigned teams plus half of its matches with the
+    // other later teams, heaviest first against the distances from x to the other free positions, nearest first.
+    // The cheapest assignment of the later teams to the free positions bounds the cost of every completion
+    long lowerBound(int t) {
+        int k = 0;
+        for(int v = 0; v < n; v++) {
+            if(!used[v]) free[k++] = search.ranking[v];
+        }
+        sort(free.begin(), free.begin() + k);
+        // Costs are doubled so the halves stay integers
+        for(int x = 0; x < k; x++) {
+            int* near = &distances[(size_t) x * n];
+            int count = 0;
+            // The distances from free[x] in increasing order, merged from both sides
+            int left = x - 1, right = x + 1;
+            while(left >= 0 || right < k) {
+                if(right >= k || (left >= 0 && free[x] - free[left] <= free[right] - free[x])) {
+                    near[count++] = free[x] - free[left--];
+                }
+                else {
+                    near[count++] = free[right++] - free[x];
+                }
+            }
+        }
+        for(int i = 0; i < k; i++) {
+            int u = t + 1 + i;
+            const long* row = &partial[(size_t) u * n];
+            const vector<long>& weights = search.neighbourWeights[t + 1][u];
+            for(int x = 0; x < k; x++) {
+                const int* near = &distances[(size_t) x * n];
+                long c = 2 * row[free[x]];
+                for(int m = 0; m < k - 1; m++) {
+                    c += weights[m] * near[m];
+                }
+                assignment[(size_t) i * n + x] = c;
+            }
+        }
+        return (cheapestAssignment(k) + 1) / 2;
+    }
+
+    // Hungarian method on the first k rows and columns of assignment
+    long cheapestAssignment(int k) {
+        vector<long>& u = potentials[0];
+        vector<long>& v = potentials[1];
+        fill(u.begin(), u.end(), 0);
+        fill(v.begin(), v.end(), 0);
+        fill(match.begin(), match.end(), 0);
+        for(int i = 1; i <= k; i++) {
+            match[0] = i;
+            int j0 = 0;
+            fill(slack.begin(), slack.end(), LONG_MAX);
+            fill(visited.begin(), visited.end(), 0);
+            do {
+                visited[j0] = 1;
+                int i0 = match[j0], j1 = 0;
+                long delta = LONG_MAX;
+                for(int j = 1; j <= k; j++) {
+                    if(visited[j]) continue;
+                    long cur = assignment[(size_t) (i0 - 1) * n + (j - 1)] - u[i0] - v[j];
+                    if(cur < slack[j]) {
+                        slack[j] = cur;
+                        way[j] = j0;
+                    }
+                    if(slack[j] < delta) {
+                        delta = slack[j];
+                        j1 = j;
+                    }
+                }
+                for(int j = 0; j <= k; j++) {
+                    if(visited[j]) {
+                        u[match[j]] += delta;
+                        v[j] -= delta;
+                    }
+                    else {
+                        slack[j] -= delta;
+                    }
+                }
+                j0 = j1;
+            } while(match[j0] != 0);
+            do {
+                int j1 = way[j0];
+                match[j0] = match[j1];
+                j0 = j1;
+            } while(j0 != 0);
+        }
+        return -v[0];
+    }
+
+    // cost holds the matches among the teams up to t. Values are tried in increasing order, so the first
+    // permutation of the smallest cost is kept. Subtrees are cut when their lower bound reaches the best cost
+    // of this branch or exceeds the best cost found anywhere
+    void descend(int t, long cost) {
+        if(t == n - 1) {
+            if(result.cost < 0 || cost < result.cost) {
+                result.cost = cost;
+                result.permutation = permutation;
+                long current = shared.load(memory_order_relaxed);
+                while(cost < current && !shared.compare_exchange_weak(current, cost, memory_order_relaxed)) {}
+            }
+            return;
+        }
+        long bound = cost + lowerBound(t);
+        if((result.cost >= 0 && bound >= result.cost) || bound > shared.load(memory_order_relaxed)) return;
+        int next = t + 1;
+        for(int v = 0; v < n; v++) {
+            if(used[v]) continue;
+            long added = partial[(size_t) next * n + search.ranking[v]];
+            assign(next, v, 1);
+            descend(next, cost + added);
+            assign(next, v, -1);
+        }
+    }
+};
+
+void MappingSearch::search(int first, int second, atomic<long>& shared, Branch& result) const {
+    Walk walk(*this, shared, result);
+    walk.assign(0, first, 1);
+    long cost = walk.partial[(size_t) 1 * numberOfTeams + ranking[second]];
+    walk.assign(1, second, 1);
+    walk.descend(1, cost);
+}
@@ -0,0 +1,45 @@
+#ifndef THESIS_MAPPINGSEARCH_H
+#define THESIS_MAPPINGSEARCH_H
+
+#include <vector>
+#include <atomic>
+
+using namespace std;
+
+// Exact search for the mapping of the exact mapping optimizations: the permutation p of the teams that minimizes
+// the sum over all matches of weight[round] * |ranking[p[home]] - ranking[p[away]]|.
+// Permutations are enumerated in place by branch and bound in lexicographic order, so the result is the first
+// of the best ones, as with a full enumeration, and memory stays O(N^2). The objective is unchanged when
+// ranking[p[.]] is mirrored, so only the half of the first level whose mirror comes later is searched.
+// The subtrees of the first two teams are searched in parallel and share the best cost found so far.
+class MappingSearch {
+private:
+    int numberOfTeams;
+    vector<int> ranking;
+    // rankOf[ranking[k]] = k
+    vector<int> rankOf;
+    // Summed round weights of the matches between two teams, N x N
+    vector<long> pairWeight;
+    // neighbourWeights[t][u]: weights of the matches of team u with the other teams from t on, heaviest first
+    vector<vector<vector<long>>> neighbourWeights;
+    struct Branch {
+        vector<int> permutation;
+        long cost = -1;
+    };
+    struct Walk;
+    void search(int first, int second, atomic<long>& shared, Branch& result) const;
+public:
+    // Worker threads the search tree is split across, the result does not depend on it
+    int threads = 1;
+    MappingSearch(const vector<int>& ranking, int** schedule, int rounds, const vector<long>& roundWeight);
+    // Integer weights of the rounds: the first half of the season falls linearly to the middle, or the second half
+    // rises linearly to the last round. They order the permutations the same way as the normalized weights
+    static vector<long> roundWeights(int rounds, bool highestLast);
+    // Summed round weights of the matches between two teams, N x N
+    static vector<long> pairWeights(int** schedule, int rounds, int numberOfTeams, const vector<long>& roundWeight);
+    long cost(const vector<int>& permutation) const;
+    vector<int> best() const;
+};
+
+
+#endif //THESIS_MAPPINGSEARCH_H
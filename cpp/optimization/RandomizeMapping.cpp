@@ -23,6 +23,7 @@ Configuration RandomizeMapping::optimize(Configuration config) {
     }
     
     Configuration optimizedConfig(config);
+    optimizedConfig.ownSchedule();
     for (int i = 0; i < config.rounds; i++) {
         for (int j = 0; j < config.numberOfTeams; j++) {
             optimizedConfig.schedule[i][j] = permutation[config.schedule[i][j]];
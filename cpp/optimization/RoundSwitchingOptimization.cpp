@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include "RoundSwitchingOptimization.h"
+#include "../calculation/SimulatedFVCalculation.h"
+#include "../calculation/ExactFVCalculation.h"
+#include "../calculation/RandomStream.h"
+#include "../helpers/ThreadPool.h"
+
+RoundSwitchingOptimization::RoundSwitchingOptimization() : Optimization() {
+}
+
+RoundSwitchingOptimization::RoundSwitchingOptimization(RoundSwitchingOptimization& other) : Optimization(other) {
+}
+
+Configuration RoundSwitchingOptimization::optimize(Configuration config) {
+    bool maximum = config.roundSwitchingObjective == "max";
+    bool mirrored = config.mirrorSchedule && config.rounds % 2 == 0;
+    OutcomeTable outcomes(*config.predictor, config.numberOfTeams);
+    vector<double> stakes[2] = {
+            roundStakes(config, outcomes, false, maximum),
+            roundStakes(config, outcomes, true, maximum)
+    };
+
+    // Seeded from the id rather than the shared rng, configurations are optimized concurrently
+    uint64_t seed = RandomStream::hash(config.id);
+    mt19937_64 gen(seed);
+    Order current;
+    current.rounds.resize(config.rounds);
+    for (int i = 0; i < config.rounds; i++) current.rounds[i] = i;
+    current.flipped.assign(config.rounds, 0);
+    current.proxy = proxy(current, stakes, maximum);
+
+    // Local optima of the proxy from the current and from random orders. When the proxy has fewer distinct optima
+    // than candidates, the random starting orders with the lowest proxy are calculated as well
+    vector<Order> orders;
+    auto remember = [&](const Order& order) {
+        if (!(order == current) && find(orders.begin(), orders.end(), order) == orders.end()) {
+            orders.push_back(order);
+        }
+    };
+    for (int r = 0; r < restarts; r++) {
+        Order start = current;
+        if (r > 0) {
+            int half = mirrored ? config.rounds / 2 : config.rounds;
+            shuffle(start.rounds.begin(), start.rounds.begin() + half, gen);
+            if (mirrored) {
+                for (int i = 0; i < half; i++) {
+                    start.rounds[i + half] = start.rounds[i] + half;
+                    start.flipped[i] = start.flipped[i + half] = (char) (gen() & 1);
+                }
+            }
+            start.proxy = proxy(start, stakes, maximum);
+        }
+        remember(improve(start, stakes, mirrored, maximum));
+        remember(start);
+    }
+    stable_sort(orders.begin(), orders.end(), [](const Order& a, const Order& b) {
+        return a.proxy < b.proxy;
+    });
+    vector<Order> candidates = {current};
+    for (const Order& order : orders) {
+        if ((int) candidates.size() > config.roundSwitchingCandidates) break;
+        candidates.push_back(order);
+    }
+
+    vector<double> fraudValues(candidates.size());
+    ThreadPool pool(max(1, config.threads));
+    pool.parallelFor((int) candidates.size(), [&](int c) {
+        fraudValues[c] = fraud(apply(config, candidates[c]), seed, maximum);
+    });
+    size_t best = 0;
+    for (size_t c = 1; c < candidates.size(); c++) {
+        if (fraudValues[c] < fraudValues[best]) best = c;
+    }
+    // The simulation streams follow the position of a game, so reordered rounds draw other numbers for the same match
+    // and the smallest of the estimates is biased toward lucky draws. The winner is only kept if it also beats
+    // the current order with new random numbers
+    if (best != 0 && config.engine == "simulated") {
+        uint64_t check = gen();
+        vector<size_t> finalists = {0, best};
+        vector<double> checked(2);
+        pool.parallelFor(2, [&](int c) {
+            checked[c] = fraud(apply(config, candidates[finalists[c]]), check, maximum);
+        });
+        if (checked[1] >= checked[0]) best = 0;
+    }
+    return apply(config, candidates[best]);
+}
+
+// Stake of every round, the sum or the largest stake of its matches. A match has a high stake when its outcome
+// is uncertain and it is played between teams of neighbouring expected ranks whose prizes differ from
+// the prizes of the ranks next to them. flipped swaps the home and away teams of every match
+vector<double> RoundSwitchingOptimization::roundStakes(const Configuration& config, const OutcomeTable& outcomes, bool flipped, bool maximum) const {
+    int n = config.numberOfTeams;
+    OutcomePatches none;
+    vector<double> expectedPoints(n, 0.0);
+    for (int a = 0; a < n; a++) {
+        for (int b = 0; b < n; b++) {
+            if (a == b) continue;
+            const float* t = outcomes.odds(a, b, none);
+            double draw = 1.0 - t[1];
+            expectedPoints[a] += 3.0 * t[0] + draw;
+            expectedPoints[b] += 3.0 * (t[1] - t[0]) + draw;
+        }
+    }
+    vector<int> order(n);
+    for (int t = 0; t < n; t++) order[t] = t;
+    stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return expectedPoints[a] > expectedPoints[b];
+    });
+    vector<int> rank(n);
+    for (int k = 0; k < n; k++) rank[order[k]] = k;
+    const vector<long double>& prizes = config.priceFunction->prizes;
+    vector<double> sensitivity(n, 0.0);
+    for (int t = 0; t < n; t++) {
+        int k = rank[t];
+        if (k > 0) sensitivity[t] = max(sensitivity[t], (double) fabsl(prizes[k] - prizes[k - 1]));
+        if (k + 1 < n) sensitivity[t] = max(sensitivity[t], (double) fabsl(prizes[k] - prizes[k + 1]));
+    }
+
+    vector<double> stakes(config.rounds, 0.0);
+    for (int i = 0; i < config.rounds; i++) {
+        for (int j = 0; j < n / 2; j++) {
+            int homeTeam = config.schedule[i][2*j];
+            int awayTeam = config.schedule[i][2*j+1];
+            if (flipped) swap(homeTeam, awayTeam);
+            const float* t = outcomes.odds(homeTeam, awayTeam, none);
+            double likeliest = max({(double) t[0], (double) (t[1] - t[0]), 1.0 - t[1]});
+            double closeness = 1.0 / (1.0 + abs(rank[homeTeam] - rank[awayTeam]));
+            double stake = (1.0 - likeliest) * closeness * (sensitivity[homeTeam] + sensitivity[awayTeam]);
+            stakes[i] = maximum ? max(stakes[i], stake) : stakes[i] + stake;
+        }
+    }
+    return stakes;
+}
+
+// Stakes weighed by the square of the share of the season played, summed or the largest
+double RoundSwitchingOptimization::proxy(const Order& order, const vector<double> stakes[2], bool maximum) const {
+    int rounds = (int) order.rounds.size();
+    double total = 0.0;
+    for (int k = 0; k < rounds; k++) {
+        double late = (double) (k + 1) / rounds;
+        double value = late * late * stakes[order.flipped[k] != 0][order.rounds[k]];
+        total = maximum ? max(total, value) : total + value;
+    }
+    return total;
+}
+
+// Swap two rounds, or two pairs of mirrored rounds, and flip pairs of mirrored rounds while the proxy improves
+RoundSwitchingOptimization::Order RoundSwitchingOptimization::improve(Order order, const vector<double> stakes[2], bool mirrored, bool maximum) const {
+    int rounds = (int) order.rounds.size();
+    int half = mirrored ? rounds / 2 : rounds;
+    order.proxy = proxy(order, stakes, maximum);
+    auto swapRounds = [&](int a, int b) {
+        swap(order.rounds[a], order.rounds[b]);
+        swap(order.flipped[a], order.flipped[b]);
+        if (mirrored) {
+            swap(order.rounds[a + half], order.rounds[b + half]);
+            swap(order.flipped[a + half], order.flipped[b + half]);
+        }
+    };
+    auto flip = [&](int a) {
+        order.flipped[a] = !order.flipped[a];
+        order.flipped[a + half] = !order.flipped[a + half];
+    };
+    for (bool improved = true; improved; ) {
+        improved = false;
+        for (int a = 0; a < half; a++) {
+            for (int b = a + 1; b < half; b++) {
+                swapRounds(a, b);
+                double value = proxy(order, stakes, maximum);
+                if (value < order.proxy) {
+                    order.proxy = value;
+                    improved = true;
+                }
+                else {
+                    swapRounds(a, b);
+                }
+            }
+            if (mirrored) {
+                flip(a);
+                double value = proxy(order, stakes, maximum);
+                if (value < order.proxy) {
+                    order.proxy = value;
+                    improved = true;
+                }
+                else {
+                    flip(a);
+                }
+            }
+        }
+    }
+    return order;
+}
+
+Configuration RoundSwitchingOptimization::apply(const Configuration& config, const Order& order) const {
+    Configuration optimizedConfig(config);
+    optimizedConfig.ownSchedule();
+    for (int k = 0; k < config.rounds; k++) {
+        for (int j = 0; j < config.numberOfTeams / 2; j++) {
+            int homeTeam = config.schedule[order.rounds[k]][2*j];
+            int awayTeam = config.schedule[order.rounds[k]][2*j+1];
+            if (order.flipped[k]) swap(homeTeam, awayTeam);
+            optimizedConfig.schedule[k][2*j] = homeTeam;
+            optimizedConfig.schedule[k][2*j+1] = awayTeam;
+        }
+    }
+    return optimizedConfig;
+}
+
+// Fraud of the schedule: per game the expected largest gain of the three collusion strategies,
+// P * max(0, FVh, FVa, FVd) summed over the score states, and of all games the sum or the largest
+double RoundSwitchingOptimization::fraud(const Configuration& config, uint64_t seed, bool maximum) const {
+    map<map<string,string>, list<vector<long double>>> results;
+    bool simulate = config.engine == "simulated";
+    if (!simulate) {
+        ExactFVCalculation exact = ExactFVCalculation(config);
+        try {
+            results = exact.calculate();
+        } catch (const StateBudgetExceeded& e) {
+            simulate = true;
+        }
+    }
+    if (simulate) {
+        SimulatedFVCalculation calc = SimulatedFVCalculation(config);
+        calc.runs = config.runs;
+        calc.seed = seed;
+        results = calc.calculate();
+    }
+    double total = 0.0;
+    for (const auto& game : results) {
+        long double gain = 0.0;
+        for (const vector<long double>& row : game.second) {
+            gain += row[0] * max({0.0L, row[1], row[2], row[3]});
+        }
+        total = maximum ? max(total, (double) gain) : total + (double) gain;
+    }
+    return total;
+}
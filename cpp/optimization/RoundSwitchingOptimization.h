@@ -0,0 +1,40 @@
+#ifndef THESIS_ROUNDSWITCHINGOPTIMIZATION_H
+#define THESIS_ROUNDSWITCHINGOPTIMIZATION_H
+
+#include "./Optimization.h"
+#include "../OutcomeTable.h"
+#include <cstdint>
+
+// Reorders the rounds of the schedule to lower the total or the largest fraud value of a game.
+// Any order of the rounds is a valid schedule. For a mirrored schedule both legs keep the same order
+// and a pair of mirrored rounds may swap its legs, which flips home and away of both.
+// Orders are first compared by a cheap proxy, the stakes of the matches weighed by how late they are played.
+// The best orders of a local search on the proxy are then calculated with the fraud value engine,
+// in parallel over config.threads workers. The order with the lowest fraud is kept if it still beats the current
+// order when both are simulated again with new random numbers.
+class RoundSwitchingOptimization: public Optimization {
+private:
+    // Source round of every position of the schedule and whether its home and away teams are flipped
+    struct Order {
+        vector<int> rounds;
+        vector<char> flipped;
+        double proxy = 0.0;
+        bool operator==(const Order& other) const {
+            return rounds == other.rounds && flipped == other.flipped;
+        }
+    };
+    // Number of starting orders of the local search, the first is the current order
+    static constexpr int restarts = 32;
+    vector<double> roundStakes(const Configuration& config, const OutcomeTable& outcomes, bool flipped, bool maximum) const;
+    double proxy(const Order& order, const vector<double> stakes[2], bool maximum) const;
+    Order improve(Order order, const vector<double> stakes[2], bool mirrored, bool maximum) const;
+    Configuration apply(const Configuration& config, const Order& order) const;
+    double fraud(const Configuration& config, uint64_t seed, bool maximum) const;
+public:
+    RoundSwitchingOptimization();
+    RoundSwitchingOptimization(RoundSwitchingOptimization& other);
+    Configuration optimize(Configuration config);
+};
+
+
+#endif //THESIS_ROUNDSWITCHINGOPTIMIZATION_H
@@ -2,12 +2,12 @@
 #ifndef THESIS_DROPPRICEFUNCTION_H
 #define THESIS_DROPPRICEFUNCTION_H
 
-#include "./PriceFunction.h"
+#include "./RankPrizePriceFunction.h"
 
-class DropPriceFunction: public PriceFunction {
+// The upper half of the table shares the prize equally
+class DropPriceFunction: public RankPrizePriceFunction {
 public:
     DropPriceFunction(int **schedule, int numberOfTeams);
-    long double* assignPrice(int** scenario, int start, int end, std::vector<int> startingScore);
     ~DropPriceFunction() override;
     PriceFunction* clone() override;
 };
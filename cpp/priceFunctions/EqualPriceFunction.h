@@ -2,12 +2,12 @@
 #ifndef THESIS_EQUALPRICEFUNCTION_H
 #define THESIS_EQUALPRICEFUNCTION_H
 
-#include "./PriceFunction.h"
+#include "./RankPrizePriceFunction.h"
 
-class EqualPriceFunction: public PriceFunction {
+// Every team gets the same prize regardless of its rank
+class EqualPriceFunction: public RankPrizePriceFunction {
 public:
     EqualPriceFunction(int **schedule, int numberOfTeams);
-    long double* assignPrice(int** scenario, int start, int end, std::vector<int> startingScore);
     ~EqualPriceFunction() override;
     PriceFunction* clone() override;
 };
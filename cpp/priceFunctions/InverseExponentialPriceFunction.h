@@ -3,12 +3,12 @@
 
 #include <cmath>
 
-#include "./PriceFunction.h"
+#include "./RankPrizePriceFunction.h"
 
-class InverseExponentialPriceFunction : public PriceFunction  {
+// Every rank gets half the prize of the rank above
+class InverseExponentialPriceFunction : public RankPrizePriceFunction  {
 public:
     InverseExponentialPriceFunction(int **schedule, int numberOfTeams);
-    long double* assignPrice(int** scenario, int start, int end, std::vector<int> startingScore);
     ~InverseExponentialPriceFunction() override;
     PriceFunction* clone() override;
 };
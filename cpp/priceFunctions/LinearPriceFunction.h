@@ -1,12 +1,12 @@
 #ifndef THESIS_LINEARPRICEFUNCTION_H
 #define THESIS_LINEARPRICEFUNCTION_H
 
-#include "./PriceFunction.h"
+#include "./RankPrizePriceFunction.h"
 
-class LinearPriceFunction : public PriceFunction  {
+// Prizes fall linearly from the champion to the last team
+class LinearPriceFunction : public RankPrizePriceFunction  {
 public:
     LinearPriceFunction(int **schedule, int numberOfTeams);
-    long double* assignPrice(int** scenario, int start, int end, std::vector<int> startingScore);
     ~LinearPriceFunction() override;
     PriceFunction* clone() override;
 };
@@ -1,6 +1,66 @@
 #include "PriceFunction.h"
+#include <cstring>
 
 PriceFunction::PriceFunction(int** schedule, int numberOfTeams){
     this->schedule = schedule;
     this->numberOfTeams = numberOfTeams;
-}
\ No newline at end of file
+    this->prizes.assign(numberOfTeams, 0.0);
+}
+
+void PriceFunction::assignPrice(const int* score, long double* price) {
+    vector<int> counts;
+    int minScore = numberOfTeams > 0 ? score[0] : 0, maxScore = minScore;
+    for(int j = 0; j < numberOfTeams; j++) {
+        minScore = min(minScore, score[j]);
+        maxScore = max(maxScore, score[j]);
+    }
+    rankPrizes(score, minScore, maxScore, counts, price);
+}
+
+void PriceFunction::assignPrices(const ScoreBlock& deltas, int first, int last, const int* startingScore, long double* prices) {
+    dispatchTeams(numberOfTeams, [&](auto teams) {
+        assignPricesFor<decltype(teams)::value>(deltas, first, last, startingScore, prices);
+    });
+}
+
+template<int N>
+void PriceFunction::assignPricesFor(const ScoreBlock& deltas, int first, int last, const int* startingScore, long double* prices) const {
+    const int teams = TeamCount<N>::size(numberOfTeams);
+    auto score = TeamCount<N>::scores(numberOfTeams);
+    vector<int> counts;
+    for(int r = first; r < last; r++) {
+        const int* delta = deltas.scenario(r);
+        long double* price = prices + (size_t)(r - first) * teams;
+        for(int j = 0; j < teams; j++) {
+            score[j] = startingScore[j] + delta[j];
+        }
+        int minScore = score[0], maxScore = score[0];
+        for(int j = 1; j < teams; j++) {
+            minScore = min(minScore, score[j]);
+            maxScore = max(maxScore, score[j]);
+        }
+        rankPrizes<N>(score.data(), minScore, maxScore, counts, price);
+    }
+}
+
+template<int N>
+void PriceFunction::rankPrizes(const int* score, int minScore, int maxScore, vector<int>& counts, long double* price) const {
+    const int teams = TeamCount<N>::size(numberOfTeams);
+    // Teams are bucketed by how many points they are behind the leader, after the prefix sum
+    // counts[b] is the first rank of bucket b
+    int spread = maxScore - minScore;
+    if(counts.size() < (size_t) spread + 2) {
+        counts.resize(spread + 2);
+    }
+    fill(counts.begin(), counts.begin() + spread + 2, 0);
+    for(int j = 0; j < teams; j++) {
+        counts[maxScore - score[j] + 1]++;
+    }
+    for(int b = 1; b <= spread + 1; b++) {
+        counts[b] += counts[b - 1];
+    }
+    // The prizes are copied as bytes, a long double assignment goes through the slow 80-bit x87 load and store
+    for(int j = 0; j < teams; j++) {
+        memcpy(&price[j], &prizes[counts[maxScore - score[j]]++], sizeof(long double));
+    }
+}
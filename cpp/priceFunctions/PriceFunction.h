@@ -2,18 +2,38 @@
 #define THESIS_PRICEFUNCTION_H
 
 #include <vector>
+#include <algorithm>
 #include <iostream>
+#include "../calculation/ScoreBlock.h"
+#include "../helpers/TeamCount.h"
 
 using namespace std;
 
+// Prizes are paid by final rank. Every price function only differs in its prize per rank,
+// the accumulation of points and the ranking are shared.
 class PriceFunction {
 public:
     int** schedule;
     int numberOfTeams;
+    // Prize of every rank, the best team has rank 0
+    vector<long double> prizes;
     PriceFunction(int** schedule, int numberOfTeams);
-    virtual long double* assignPrice(int** scenario, int start, int end, vector<int> startingScore) = 0;
+    // Price final standings, score holds the points of every team
+    virtual void assignPrice(const int* score, long double* price);
+    // Price the scenarios first .. last of a block at once, the final standings of scenario r are startingScore plus row r.
+    // Writes one row of prizes per scenario into the caller-owned prices buffer of (last - first) x numberOfTeams
+    virtual void assignPrices(const ScoreBlock& deltas, int first, int last, const int* startingScore, long double* prices);
     virtual ~PriceFunction() {};
     virtual PriceFunction* clone() = 0;
+protected:
+    // Rank the teams by points with a counting sort and pay the prize of every rank.
+    // Teams with equal points are ranked by team index. counts is scratch space that grows with the gap between
+    // the lowest and the highest score. N is the number of teams if it is known at compile time, 0 uses numberOfTeams
+    template<int N = 0>
+    void rankPrizes(const int* score, int minScore, int maxScore, vector<int>& counts, long double* price) const;
+private:
+    template<int N>
+    void assignPricesFor(const ScoreBlock& deltas, int first, int last, const int* startingScore, long double* prices) const;
 };
 
 
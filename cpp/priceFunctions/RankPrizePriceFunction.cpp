@@ -0,0 +1,109 @@
+#include "RankPrizePriceFunction.h"
+#include <stdexcept>
+
+RankPrizePriceFunction::RankPrizePriceFunction(int** schedule, int numberOfTeams, const vector<long double>& prizes) : PriceFunction(schedule, numberOfTeams) {
+    copy(prizes.begin(), prizes.begin() + min(prizes.size(), this->prizes.size()), this->prizes.begin());
+    compile();
+}
+
+vector<long double> RankPrizePriceFunction::parseTable(const string& description, int numberOfTeams) {
+    vector<long double> prizes;
+    size_t start = description.find(';');
+    while(start != string::npos) {
+        size_t end = description.find(';', start + 1);
+        string value = description.substr(start + 1, end == string::npos ? string::npos : end - start - 1);
+        if(!value.empty()) {
+            prizes.push_back(stold(value));
+        }
+        start = end;
+    }
+    if((int) prizes.size() > numberOfTeams) {
+        throw runtime_error("Error: prize table " + description + " has more ranks than the " + to_string(numberOfTeams) + " teams");
+    }
+    return prizes;
+}
+
+void RankPrizePriceFunction::compile() {
+    payingRanks = numberOfTeams;
+    while(payingRanks > 0 && prizes[payingRanks - 1] == prizes[numberOfTeams - 1]) {
+        payingRanks--;
+    }
+}
+
+void RankPrizePriceFunction::assignPrice(const int* score, long double* price) {
+    if(payingRanks > maxSelection) {
+        PriceFunction::assignPrice(score, price);
+        return;
+    }
+    selectPrizes(score, price);
+}
+
+void RankPrizePriceFunction::assignPrices(const ScoreBlock& deltas, int first, int last, const int* startingScore, long double* prices) {
+    if(payingRanks > maxSelection) {
+        PriceFunction::assignPrices(deltas, first, last, startingScore, prices);
+        return;
+    }
+    dispatchTeams(numberOfTeams, [&](auto teams) {
+        constexpr int N = decltype(teams)::value;
+        switch(payingRanks) {
+            case 0: selectPrizes<0, N>(deltas, first, last, startingScore, prices); break;
+            case 1: selectPrizes<1, N>(deltas, first, last, startingScore, prices); break;
+            case 2: selectPrizes<2, N>(deltas, first, last, startingScore, prices); break;
+            default: selectPrizes<3, N>(deltas, first, last, startingScore, prices); break;
+        }
+    });
+}
+
+template<int K, int N>
+void RankPrizePriceFunction::selectPrizes(const ScoreBlock& deltas, int first, int last, const int* startingScore, long double* prices) const {
+    const int teams = TeamCount<N>::size(numberOfTeams);
+    auto score = TeamCount<N>::scores(numberOfTeams);
+    for(int r = first; r < last; r++) {
+        const int* delta = deltas.scenario(r);
+        for(int j = 0; j < teams; j++) {
+            score[j] = startingScore[j] + delta[j];
+        }
+        topPrizes<K, N>(score.data(), prices + (size_t)(r - first) * teams);
+    }
+}
+
+void RankPrizePriceFunction::selectPrizes(const int* score, long double* price) const {
+    switch(payingRanks) {
+        case 0: topPrizes<0>(score, price); break;
+        case 1: topPrizes<1>(score, price); break;
+        case 2: topPrizes<2>(score, price); break;
+        default: topPrizes<3>(score, price); break;
+    }
+}
+
+// Keep the K best teams in a small sorted list, a team only displaces teams with fewer points,
+// so equal points are ranked by team index like the full ranking does
+template<int K, int N>
+void RankPrizePriceFunction::topPrizes(const int* score, long double* price) const {
+    const int teams = TeamCount<N>::size(numberOfTeams);
+    fill(price, price + teams, teams > 0 ? prizes[teams - 1] : 0.0L);
+    if constexpr (K > 0) {
+        int best[K] = {};
+        int count = 0;
+        for(int j = 0; j < teams; j++) {
+            int k = count;
+            while(k > 0 && score[j] > score[best[k - 1]]) k--;
+            if(k >= K) continue;
+            for(int m = min(count, K - 1); m > k; m--) {
+                best[m] = best[m - 1];
+            }
+            best[k] = j;
+            count = min(count + 1, K);
+        }
+        for(int k = 0; k < count; k++) {
+            price[best[k]] = prizes[k];
+        }
+    }
+}
+
+PriceFunction* RankPrizePriceFunction::clone() {
+    return new RankPrizePriceFunction(*this);
+}
+
+RankPrizePriceFunction::~RankPrizePriceFunction() {
+}
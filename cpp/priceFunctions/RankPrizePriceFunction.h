@@ -0,0 +1,35 @@
+#ifndef THESIS_RANKPRIZEPRICEFUNCTION_H
+#define THESIS_RANKPRIZEPRICEFUNCTION_H
+
+#include <string>
+#include "./PriceFunction.h"
+
+// Pays a fixed prize per rank, given as a table.
+// If only the first few ranks are paid differently from the rest, the teams on these ranks are found
+// with a partial selection instead of ranking the whole league.
+class RankPrizePriceFunction : public PriceFunction {
+public:
+    // Largest number of individually paid ranks that use the partial selection
+    static const int maxSelection = 3;
+    RankPrizePriceFunction(int **schedule, int numberOfTeams, const vector<long double>& prizes = {});
+    // Prize table of a "table;<prize of rank 0>;<prize of rank 1>;..." description, unlisted ranks get no prize
+    static vector<long double> parseTable(const string& description, int numberOfTeams);
+    void assignPrice(const int* score, long double* price) override;
+    void assignPrices(const ScoreBlock& deltas, int first, int last, const int* startingScore, long double* prices) override;
+    ~RankPrizePriceFunction() override;
+    PriceFunction* clone() override;
+protected:
+    // Number of leading ranks whose prize differs from the prize of the last rank
+    int payingRanks = 0;
+    // Choose the ranking kernel for the prize table, called after the prizes changed
+    void compile();
+private:
+    void selectPrizes(const int* score, long double* price) const;
+    template<int K, int N>
+    void selectPrizes(const ScoreBlock& deltas, int first, int last, const int* startingScore, long double* prices) const;
+    template<int K, int N = 0>
+    void topPrizes(const int* score, long double* price) const;
+};
+
+
+#endif //THESIS_RANKPRIZEPRICEFUNCTION_H
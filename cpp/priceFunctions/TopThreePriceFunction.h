@@ -1,12 +1,12 @@
 #ifndef THESIS_TOPTHREEPRICEFUNCTION_H
 #define THESIS_TOPTHREEPRICEFUNCTION_H
 
-#include "./PriceFunction.h"
+#include "./RankPrizePriceFunction.h"
 
-class TopThreePriceFunction : public PriceFunction   {
+// The first three teams share the prize 60 / 30 / 10
+class TopThreePriceFunction : public RankPrizePriceFunction   {
 public:
     TopThreePriceFunction(int **schedule, int numberOfTeams);
-    long double* assignPrice(int** scenario, int start, int end, std::vector<int> startingScore);
     ~TopThreePriceFunction() override;
     PriceFunction* clone() override;
 };
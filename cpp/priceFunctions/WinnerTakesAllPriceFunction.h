@@ -2,12 +2,12 @@
 #ifndef THESIS_WINNERTAKESALLPRICEFUNCTION_H
 #define THESIS_WINNERTAKESALLPRICEFUNCTION_H
 
-#include "./PriceFunction.h"
+#include "./RankPrizePriceFunction.h"
 
-class WinnerTakesAllPriceFunction : public PriceFunction {
+// The champion gets the whole prize
+class WinnerTakesAllPriceFunction : public RankPrizePriceFunction {
 public:
     WinnerTakesAllPriceFunction(int **schedule, int numberOfTeams);
-    long double* assignPrice(int** scenario, int start, int end, std::vector<int> startingScore);
     ~WinnerTakesAllPriceFunction() override;
     PriceFunction* clone() override;
 };
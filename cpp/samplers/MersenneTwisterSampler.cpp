@@ -0,0 +1,17 @@
+#include "MersenneTwisterSampler.h"
+#include <random>
+#include "../calculation/RandomStream.h"
+
+MersenneTwisterSampler::MersenneTwisterSampler(uint64_t key) {
+    this->key = key;
+}
+
+void MersenneTwisterSampler::fill(uint64_t run, float* out, int n, int /*group*/) const {
+    uint64_t seed = RandomStream::derive(key, run);
+    seed_seq sequence = {(uint32_t) seed, (uint32_t) (seed >> 32)};
+    mt19937 engine(sequence);
+    uniform_real_distribution<float> uniform(0, 1);
+    for(int i = 0; i < n; i++) {
+        out[i] = uniform(engine);
+    }
+}
@@ -0,0 +1,16 @@
+#ifndef THESIS_MERSENNETWISTERSAMPLER_H
+#define THESIS_MERSENNETWISTERSAMPLER_H
+
+#include "./Sampler.h"
+
+// Independent numbers from mt19937 with uniform_real_distribution<float>, as the simulation originally drew them.
+// The generator is seeded from the stream key and the run, so runs stay independent of the thread order
+class MersenneTwisterSampler : public Sampler {
+public:
+    uint64_t key;
+    MersenneTwisterSampler(uint64_t key);
+    void fill(uint64_t run, float* out, int n, int group) const override;
+};
+
+
+#endif //THESIS_MERSENNETWISTERSAMPLER_H
@@ -0,0 +1,8 @@
+#include "PhiloxSampler.h"
+
+PhiloxSampler::PhiloxSampler(uint64_t key) : random(key) {
+}
+
+void PhiloxSampler::fill(uint64_t run, float* out, int n, int /*group*/) const {
+    random.fill(run, out, n);
+}
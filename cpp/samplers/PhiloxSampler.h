@@ -0,0 +1,16 @@
+#ifndef THESIS_PHILOXSAMPLER_H
+#define THESIS_PHILOXSAMPLER_H
+
+#include "./Sampler.h"
+#include "../calculation/RandomStream.h"
+
+// Independent numbers from the counter-based Philox generator, the default sampler
+class PhiloxSampler : public Sampler {
+public:
+    RandomStream random;
+    PhiloxSampler(uint64_t key);
+    void fill(uint64_t run, float* out, int n, int group) const override;
+};
+
+
+#endif //THESIS_PHILOXSAMPLER_H
@@ -0,0 +1,18 @@
+#include "Sampler.h"
+#include <stdexcept>
+#include "./PhiloxSampler.h"
+#include "./MersenneTwisterSampler.h"
+#include "./XoshiroSampler.h"
+#include "./SobolSampler.h"
+
+unique_ptr<Sampler> Sampler::create(const string& name, uint64_t key) {
+    if(name == "philox") return make_unique<PhiloxSampler>(key);
+    if(name == "mt19937") return make_unique<MersenneTwisterSampler>(key);
+    if(name == "xoshiro") return make_unique<XoshiroSampler>(key);
+    if(name == "sobol") return make_unique<SobolSampler>(key);
+    throw runtime_error("Error: unknown sampler " + name + ", expected philox, mt19937, xoshiro or sobol");
+}
+
+bool Sampler::exists(const string& name) {
+    return name == "philox" || name == "mt19937" || name == "xoshiro" || name == "sobol";
+}
@@ -0,0 +1,24 @@
+#ifndef THESIS_SAMPLER_H
+#define THESIS_SAMPLER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+using namespace std;
+
+// Source of the uniform numbers that decide the match outcomes of a simulation.
+// Every run can be generated on its own, so runs can be simulated on any thread in any order.
+// The numbers of a run are laid out in groups, one group per round with one number per game.
+class Sampler {
+public:
+    virtual ~Sampler() {};
+    // The first n uniform floats in [0, 1) of a run
+    virtual void fill(uint64_t run, float* out, int n, int group) const = 0;
+    // Sampler by its configuration name, key selects the random stream
+    static unique_ptr<Sampler> create(const string& name, uint64_t key);
+    static bool exists(const string& name);
+};
+
+
+#endif //THESIS_SAMPLER_H
@@ -0,0 +1,101 @@
+#include "SobolSampler.h"
+#include <stdexcept>
+#include <string>
+#include "../calculation/RandomStream.h"
+
+// Primitive polynomials and initial direction numbers of the dimensions 2 .. 16 (Joe and Kuo, new-joe-kuo-6.21201):
+// degree s, coefficients a, and m_1 .. m_s
+static const int SOBOL_DEGREE[] = {1, 2, 3, 3, 4, 4, 5, 5, 5, 5, 5, 5, 6, 6, 6};
+static const int SOBOL_COEFFICIENTS[] = {0, 1, 1, 2, 1, 4, 2, 4, 7, 11, 13, 14, 1, 13, 16};
+static const int SOBOL_INITIAL[][6] = {
+        {1},
+        {1, 3},
+        {1, 3, 1},
+        {1, 1, 1},
+        {1, 1, 3, 3},
+        {1, 3, 5, 13},
+        {1, 1, 5, 5, 17},
+        {1, 1, 5, 5, 5},
+        {1, 1, 7, 11, 19},
+        {1, 1, 5, 1, 1},
+        {1, 1, 1, 3, 11},
+        {1, 3, 5, 5, 31},
+        {1, 3, 3, 9, 7, 49},
+        {1, 1, 1, 15, 21, 21},
+        {1, 3, 1, 13, 27, 49}
+};
+
+struct SobolDirections {
+    uint32_t v[SobolSampler::dimensions][32];
+    SobolDirections() {
+        for(int k = 0; k < 32; k++) {
+            v[0][k] = 1u << (31 - k);
+        }
+        for(int d = 1; d < SobolSampler::dimensions; d++) {
+            int s = SOBOL_DEGREE[d - 1];
+            int a = SOBOL_COEFFICIENTS[d - 1];
+            for(int k = 0; k < 32; k++) {
+                if(k < s) {
+                    v[d][k] = (uint32_t) SOBOL_INITIAL[d - 1][k] << (31 - k);
+                    continue;
+                }
+                v[d][k] = v[d][k - s] ^ (v[d][k - s] >> s);
+                for(int l = 1; l < s; l++) {
+                    if((a >> (s - 1 - l)) & 1) {
+                        v[d][k] ^= v[d][k - l];
+                    }
+                }
+            }
+        }
+    }
+};
+
+static const SobolDirections& directions() {
+    static const SobolDirections table;
+    return table;
+}
+
+SobolSampler::SobolSampler(uint64_t key) {
+    this->key = key;
+}
+
+uint32_t SobolSampler::point(uint32_t index, int dimension) {
+    const uint32_t* v = directions().v[dimension];
+    uint32_t x = 0;
+    for(int k = 0; index != 0; k++, index >>= 1) {
+        if(index & 1) x ^= v[k];
+    }
+    return x;
+}
+
+static uint32_t reverseBits(uint32_t x) {
+    x = ((x >> 1) & 0x55555555u) | ((x & 0x55555555u) << 1);
+    x = ((x >> 2) & 0x33333333u) | ((x & 0x33333333u) << 2);
+    x = ((x >> 4) & 0x0F0F0F0Fu) | ((x & 0x0F0F0F0Fu) << 4);
+    x = ((x >> 8) & 0x00FF00FFu) | ((x & 0x00FF00FFu) << 8);
+    return (x >> 16) | (x << 16);
+}
+
+uint32_t SobolSampler::scramble(uint32_t x, uint32_t seed) {
+    x = reverseBits(x);
+    x += seed;
+    x ^= x * 0x6c50b47cu;
+    x ^= x * 0xb82f1e52u;
+    x ^= x * 0xc7afe638u;
+    x ^= x * 0x8d22f6e6u;
+    return reverseBits(x);
+}
+
+void SobolSampler::fill(uint64_t run, float* out, int n, int group) const {
+    if(group > dimensions) {
+        throw runtime_error("Error: the sobol sampler supports at most " + to_string(dimensions) + " games per round");
+    }
+    for(int start = 0; start < n; start += group) {
+        uint64_t seed = RandomStream::derive(key, (uint64_t) (start / group));
+        uint32_t index = scramble((uint32_t) run, (uint32_t) seed);
+        for(int d = 0; d < group && start + d < n; d++) {
+            uint32_t bits = scramble(point(index, d), (uint32_t) RandomStream::derive(seed, (uint64_t) d + 1));
+            out[start + d] = RandomStream::uniform(bits);
+        }
+    }
+}
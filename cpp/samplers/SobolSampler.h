@@ -0,0 +1,24 @@
+#ifndef THESIS_SOBOLSAMPLER_H
+#define THESIS_SOBOLSAMPLER_H
+
+#include "./Sampler.h"
+
+// Randomized quasi-Monte Carlo numbers from an Owen-scrambled Sobol sequence.
+// Each round is one point of a Sobol sequence with one dimension per game, the run is the point index.
+// Rounds are padded together by shuffling the point index and scrambling the digits with a separate seed per round,
+// so the runs are stratified within every round while the rounds stay independent of each other.
+class SobolSampler : public Sampler {
+public:
+    // Number of Sobol dimensions, the largest number of games per round
+    static constexpr int dimensions = 16;
+    uint64_t key;
+    SobolSampler(uint64_t key);
+    void fill(uint64_t run, float* out, int n, int group) const override;
+    // Unscrambled coordinate of a point of the sequence as a 32-bit fraction
+    static uint32_t point(uint32_t index, int dimension);
+    // Nested uniform scramble of the digits of x (Laine-Karras hash on the reversed bits)
+    static uint32_t scramble(uint32_t x, uint32_t seed);
+};
+
+
+#endif //THESIS_SOBOLSAMPLER_H
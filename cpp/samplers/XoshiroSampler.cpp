@@ -0,0 +1,29 @@
+#include "XoshiroSampler.h"
+#include "../calculation/RandomStream.h"
+
+XoshiroSampler::XoshiroSampler(uint64_t key) {
+    this->key = key;
+}
+
+static inline uint32_t rotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+void XoshiroSampler::fill(uint64_t run, float* out, int n, int /*group*/) const {
+    // The state is filled by splitmix64, which never yields an all-zero state for two consecutive outputs
+    uint64_t seed = RandomStream::derive(key, run);
+    uint64_t a = RandomStream::derive(seed, 0);
+    uint64_t b = RandomStream::derive(seed, 1);
+    uint32_t s[4] = {(uint32_t) a, (uint32_t) (a >> 32), (uint32_t) b, (uint32_t) (b >> 32)};
+    for(int i = 0; i < n; i++) {
+        uint32_t result = s[0] + s[3];
+        uint32_t t = s[1] << 9;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 11);
+        out[i] = RandomStream::uniform(result);
+    }
+}
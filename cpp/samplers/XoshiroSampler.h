@@ -0,0 +1,15 @@
+#ifndef THESIS_XOSHIROSAMPLER_H
+#define THESIS_XOSHIROSAMPLER_H
+
+#include "./Sampler.h"
+
+// Independent numbers from xoshiro128+, a small and fast generator seeded per run from the stream key
+class XoshiroSampler : public Sampler {
+public:
+    uint64_t key;
+    XoshiroSampler(uint64_t key);
+    void fill(uint64_t run, float* out, int n, int group) const override;
+};
+
+
+#endif //THESIS_XOSHIROSAMPLER_H